@@ -131,23 +131,33 @@ def get_files_to_copy_and_zip(lab):
         files.append((chk_lab_path / "drivers.cmake", dest_libs_path / "CMakeLists.txt", False))
         files.append((src_libs_path / "buttons.c", dest_libs_path, True))
         files.append((src_libs_path / "switches.c", dest_libs_path, True))
+        files.append((src_libs_path / "interrupts.c", dest_libs_path, False))
+        files.append((src_libs_path / "intervalTimer.c", dest_libs_path, False))
+        files.append((src_libs_path / "timestamp.c", dest_libs_path, False))
+        files.append((src_libs_path / "idle.c", dest_libs_path, False))
         files.append((src_lab_path / "gpioTest.c", dest_lab_path, True))
     elif lab == "lab3":
         files.append((chk_lab_path / "drivers.cmake", dest_libs_path / "CMakeLists.txt", False))
         files.append((chk_lab_path / "cmake", dest_lab_path / "CMakeLists.txt", False))
         files.append((src_libs_path / "buttons.c", dest_libs_path, False))
         files.append((src_libs_path / "switches.c", dest_libs_path, False))
+        files.append((src_libs_path / "timestamp.c", dest_libs_path, False))
+        files.append((src_libs_path / "idle.c", dest_libs_path, False))
         files.append((src_libs_path / "intervalTimer.c", dest_libs_path, True))
     elif lab == "lab4":
         files.append((chk_lab_path / "drivers.cmake", dest_libs_path / "CMakeLists.txt", False))
         files.append((chk_lab_path / "cmake", dest_lab_path / "CMakeLists.txt", False))
         files.append((src_libs_path / "interrupts.c", dest_libs_path, True))
+        files.append((src_libs_path / "timestamp.c", dest_libs_path, False))
+        files.append((src_libs_path / "idle.c", dest_libs_path, False))
         files.append((src_lab_path / "interrupt_test.c", dest_lab_path, True))
         files.append((src_libs_path / "intervalTimer.c", dest_libs_path, False))
     elif lab == "lab5":
         files.append((chk_lab_path / "drivers.cmake", dest_libs_path / "CMakeLists.txt", False))
         files.append((chk_lab_path / "cmake", dest_lab_path / "CMakeLists.txt", False))
         files.append((src_libs_path / "interrupts.c", dest_libs_path, False))
+        files.append((src_libs_path / "timestamp.c", dest_libs_path, False))
+        files.append((src_libs_path / "idle.c", dest_libs_path, False))
         files.append((src_libs_path / "intervalTimer.c", dest_libs_path, False))
         files.append((src_libs_path / "touchscreen.c", dest_libs_path, True))
     elif lab == "lab6":
@@ -155,53 +165,99 @@ def get_files_to_copy_and_zip(lab):
         files.append((chk_lab_path / "cmake", dest_lab_path / "CMakeLists.txt", False))
         files.append((src_libs_path / "intervalTimer.c", dest_libs_path, False))
         files.append((src_libs_path / "interrupts.c", dest_libs_path, False))
+        files.append((src_libs_path / "timestamp.c", dest_libs_path, False))
+        files.append((src_libs_path / "idle.c", dest_libs_path, False))
+        files.append((src_libs_path / "scheduler.c", dest_libs_path, False))
         files.append((src_libs_path / "touchscreen.c", dest_libs_path, False))
+        files.append((src_libs_path / "textField.c", dest_libs_path, False))
         files.append((src_lab_path / "clockControl.c", dest_lab_path, True))
     elif lab == "lab7m1":
         files.append((chk_lab_path / "drivers.cmake", dest_libs_path / "CMakeLists.txt", False))
         files.append((chk_lab_path / "cmake", dest_lab_path / "CMakeLists.txt", False))
+        files.append((src_libs_path / "taskRunner.c", dest_libs_path, False))
+        files.append((src_libs_path / "timestamp.c", dest_libs_path, False))
         files.append((src_lab_path / "minimax.c", dest_lab_path, True))
+        files.append((src_lab_path / "ticTacToeBitboard.c", dest_lab_path, True))
+        files.append((src_lab_path / "transpositionTable.c", dest_lab_path, True))
+        files.append((src_lab_path / "openingBook.c", dest_lab_path, True))
+        files.append((src_lab_path / "openingBookData.c", dest_lab_path, True))
         files.append((src_lab_path / "testBoards.c", dest_lab_path, True))
     elif lab == "lab7m2":
         files.append((chk_lab_path / "drivers.cmake", dest_libs_path / "CMakeLists.txt", False))
         files.append((chk_lab_path / "cmake", dest_lab_path / "CMakeLists.txt", False))
         files.append((src_libs_path / "buttons.c", dest_libs_path, False))
         files.append((src_libs_path / "switches.c", dest_libs_path, False))
+        files.append((src_libs_path / "idle.c", dest_libs_path, False))
+        files.append((src_libs_path / "scheduler.c", dest_libs_path, False))
         files.append((src_libs_path / "interrupts.c", dest_libs_path, False))
+        files.append((src_libs_path / "timestamp.c", dest_libs_path, False))
         files.append((src_libs_path / "touchscreen.c", dest_libs_path, False))
         files.append((src_libs_path / "intervalTimer.c", dest_libs_path, False))
+        files.append((src_libs_path / "taskRunner.c", dest_libs_path, False))
         files.append((src_lab_path / "ticTacToeControl.c", dest_lab_path, True))
         files.append((src_lab_path / "minimax.c", dest_lab_path, True))
+        files.append((src_lab_path / "ticTacToeBitboard.c", dest_lab_path, True))
+        files.append((src_lab_path / "transpositionTable.c", dest_lab_path, True))
+        files.append((src_lab_path / "openingBook.c", dest_lab_path, True))
+        files.append((src_lab_path / "openingBookData.c", dest_lab_path, True))
     elif lab == "lab8m1":
         files.append((chk_lab_path / "drivers.cmake", dest_libs_path / "CMakeLists.txt", False))
         files.append((chk_lab_path / "cmake", dest_lab_path / "CMakeLists.txt", False))
         files.append((src_libs_path / "interrupts.c", dest_libs_path, False))
+        files.append((src_libs_path / "timestamp.c", dest_libs_path, False))
+        files.append((src_libs_path / "idle.c", dest_libs_path, False))
         files.append((src_libs_path / "intervalTimer.c", dest_libs_path, False))
+        files.append((src_libs_path / "displayLine.c", dest_libs_path, False))
+        files.append((src_libs_path / "displayCircle.c", dest_libs_path, False))
         files.append((src_lab_path / "missile.c", dest_lab_path, True))
+        files.append((src_lab_path / "missilePool.c", dest_lab_path, True))
+        files.append((src_lab_path / "gameRandom.c", dest_lab_path, True))
     elif lab == "lab8m2":
         files.append((chk_lab_path / "drivers.cmake", dest_libs_path / "CMakeLists.txt", False))
         files.append((chk_lab_path / "cmake", dest_lab_path / "CMakeLists.txt", False))
         files.append((src_libs_path / "interrupts.c", dest_libs_path, False))
+        files.append((src_libs_path / "timestamp.c", dest_libs_path, False))
+        files.append((src_libs_path / "idle.c", dest_libs_path, False))
         files.append((src_libs_path / "touchscreen.c", dest_libs_path, False))
         files.append((src_libs_path / "intervalTimer.c", dest_libs_path, False))
+        files.append((src_libs_path / "textField.c", dest_libs_path, False))
+        files.append((src_libs_path / "displayLine.c", dest_libs_path, False))
+        files.append((src_libs_path / "displayCircle.c", dest_libs_path, False))
         files.append((src_lab_path / "missile.c", dest_lab_path, True))
+        files.append((src_lab_path / "missilePool.c", dest_lab_path, True))
+        files.append((src_lab_path / "gameRandom.c", dest_lab_path, True))
         files.append((src_lab_path / "gameControl.c", dest_lab_path, True))
+        files.append((src_lab_path / "collisionGrid.c", dest_lab_path, True))
     elif lab == "lab8m3":
         files.append((chk_lab_path / "drivers.cmake", dest_libs_path / "CMakeLists.txt", False))
         files.append((chk_lab_path / "cmake", dest_lab_path / "CMakeLists.txt", False))
         files.append((src_libs_path / "interrupts.c", dest_libs_path, False))
+        files.append((src_libs_path / "timestamp.c", dest_libs_path, False))
+        files.append((src_libs_path / "idle.c", dest_libs_path, False))
         files.append((src_libs_path / "touchscreen.c", dest_libs_path, False))
         files.append((src_libs_path / "intervalTimer.c", dest_libs_path, False))
+        files.append((src_libs_path / "textField.c", dest_libs_path, False))
+        files.append((src_libs_path / "displayLine.c", dest_libs_path, False))
+        files.append((src_libs_path / "displayCircle.c", dest_libs_path, False))
+        files.append((src_libs_path / "framePacer.c", dest_libs_path, False))
+        files.append((src_libs_path / "timerWheel.c", dest_libs_path, False))
         files.append((src_lab_path / "missile.c", dest_lab_path, True))
+        files.append((src_lab_path / "missilePool.c", dest_lab_path, True))
+        files.append((src_lab_path / "gameRandom.c", dest_lab_path, True))
         files.append((src_lab_path / "plane.c", dest_lab_path, True))
         files.append((src_lab_path / "gameControl.c", dest_lab_path, True))
+        files.append((src_lab_path / "collisionGrid.c", dest_lab_path, True))
     elif lab == "lab9":
         files.append((chk_lab_path / "drivers.cmake", dest_libs_path / "CMakeLists.txt", False))
         files.append((src_libs_path / "buttons.c", dest_libs_path, False))
         files.append((src_libs_path / "switches.c", dest_libs_path, False))
+        files.append((src_libs_path / "idle.c", dest_libs_path, False))
         files.append((src_libs_path / "interrupts.c", dest_libs_path, False))
+        files.append((src_libs_path / "timestamp.c", dest_libs_path, False))
         files.append((src_libs_path / "touchscreen.c", dest_libs_path, False))
         files.append((src_libs_path / "intervalTimer.c", dest_libs_path, False))
+        files.append((src_libs_path / "timerWheel.c", dest_libs_path, False))
+        files.append((src_libs_path / "input.c", dest_libs_path, False))
         for f in src_lab_path.iterdir():
             files.append((f, dest_lab_path, True))
 
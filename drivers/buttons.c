@@ -2,16 +2,40 @@
 #include "xil_io.h"
 #include "xparameters.h"
 
+#include "idle.h"
+#if XPAR_PUSH_BUTTONS_INTERRUPT_PRESENT
+#include "interrupts.h"
+#endif
+
 // Defining offsets from base address for the button device drivers
 #define BUTTONS_DATA_ADDR_OFFSET 0x00
 #define BUTTONS_TRI_ADDR_OFFSET 0x04
+#define BUTTONS_GIER_ADDR_OFFSET 0x11C   // Global interrupt enable
+#define BUTTONS_IP_ISR_ADDR_OFFSET 0x120 // Interrupt status (write to clear)
+#define BUTTONS_IP_IER_ADDR_OFFSET 0x128 // Interrupt enable
+
+// Interrupt register bits
+#define BUTTONS_GIER_ENABLE_MASK 0x80000000
+#define BUTTONS_CHANNEL1_MASK 0x1
 
 // Configure each button as an input by deactivating tri-state drivers
 #define BUTTONS_TRI_DISABLE 0x0F
 
+// True once buttons_enableWakeups() has been called, so waiting can sleep
+static bool wakeupsEnabled = false;
+
+// buttons_waitForChange() waits for the buttons to read something other than
+// waitFrom, and keeps the value that differed in lastRead
+static uint8_t waitFrom;
+static uint8_t lastRead;
+
 // Declare some helper functions
 static uint32_t readRegister(uint32_t offset);
 static void writeRegister(uint32_t offset, uint32_t value);
+static bool buttonsChanged();
+#if XPAR_PUSH_BUTTONS_INTERRUPT_PRESENT
+static void buttons_isr();
+#endif
 
 /***********HEADER FUNCTIONS************/
 
@@ -24,6 +48,32 @@ void buttons_init() {
 // Returns the state of the 4 buttons in one packaged integer
 uint8_t buttons_read() { return readRegister(BUTTONS_DATA_ADDR_OFFSET); }
 
+// Let waiting sleep, using the GPIO interrupt if there is one
+bool buttons_enableWakeups() {
+  wakeupsEnabled = true;
+#if XPAR_PUSH_BUTTONS_INTERRUPT_PRESENT
+  interrupts_register(XPAR_AXI_INTC_0_PUSH_BUTTONS_IP2INTC_IRPT_INTR,
+                      buttons_isr);
+  interrupts_irq_enable(XPAR_AXI_INTC_0_PUSH_BUTTONS_IP2INTC_IRPT_INTR);
+  writeRegister(BUTTONS_IP_IER_ADDR_OFFSET, BUTTONS_CHANNEL1_MASK);
+  writeRegister(BUTTONS_GIER_ADDR_OFFSET, BUTTONS_GIER_ENABLE_MASK);
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Wait until the buttons read differently from last
+uint8_t buttons_waitForChange(uint8_t last) {
+  waitFrom = last;
+  if (wakeupsEnabled)
+    idle_waitUntil(buttonsChanged);
+  else
+    while (!buttonsChanged())
+      ;
+  return lastRead;
+}
+
 /***********HELPER FUNCTIONS************/
 
 // Reads from the buttons' device base register address
@@ -36,4 +86,20 @@ static uint32_t readRegister(uint32_t offset) {
 // register address + the given address offset
 static void writeRegister(uint32_t offset, uint32_t value) {
   Xil_Out32(XPAR_PUSH_BUTTONS_BASEADDR + offset, value);
-}
\ No newline at end of file
+}
+
+// Read the buttons and return true if they differ from waitFrom. Called with
+// interrupts masked from idle_waitUntil(), so a change can't slip in between
+// this read and the CPU going to sleep.
+static bool buttonsChanged() {
+  lastRead = buttons_read();
+  return lastRead != waitFrom;
+}
+
+#if XPAR_PUSH_BUTTONS_INTERRUPT_PRESENT
+// Acknowledge a change of the buttons. The interrupt is only there to wake the
+// CPU, the waiting code reads the new value itself.
+static void buttons_isr() {
+  writeRegister(BUTTONS_IP_ISR_ADDR_OFFSET, BUTTONS_CHANNEL1_MASK);
+}
+#endif
@@ -12,6 +12,7 @@ For questions, contact Brad Hutchings or Jeff Goeders, https://ece.byu.edu/
 #ifndef BUTTONS
 #define BUTTONS
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #define BUTTONS_BTN0_MASK 0x1
@@ -26,4 +27,15 @@ void buttons_init();
 // returned value. bit3 = BTN3, bit2 = BTN2, bit1 = BTN1, bit0 = BTN0.
 uint8_t buttons_read();
 
+// Let buttons_waitForChange() sleep until an interrupt instead of reading the
+// buttons over and over. If this hardware build connects the button GPIO's
+// interrupt, it is registered with the interrupts driver (call this after
+// interrupts_init()) and true is returned. Otherwise false is returned, and
+// the caller must keep some other interrupt coming, such as a periodic timer,
+// so that changes are still seen.
+bool buttons_enableWakeups();
+
+// Wait until the buttons read differently from last, and return the new value.
+uint8_t buttons_waitForChange(uint8_t last);
+
 #endif /* BUTTONS */
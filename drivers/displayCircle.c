@@ -0,0 +1,82 @@
+#include "displayCircle.h"
+
+#include <stdbool.h>
+
+#include "display.h"
+
+// Number of entries in the half-width table. A circle of radius r needs r + 1
+// entries (rows 0 through r), stored one radius after another.
+#define TABLE_SIZE                                                             \
+  ((DISPLAYCIRCLE_MAX_RADIUS + 1) * (DISPLAYCIRCLE_MAX_RADIUS + 2) / 2)
+
+// Index of the first entry of the given radius in the table.
+#define TABLE_OFFSET(radius) ((radius) * ((radius) + 1) / 2)
+
+// halfWidths[TABLE_OFFSET(r) + dy] is the half-width of row dy of a circle of
+// radius r.
+static uint8_t halfWidths[TABLE_SIZE];
+static bool tableBuilt = false;
+
+/***********HELPER FUNCTIONS************/
+
+// Integer square root, rounded down.
+static uint16_t isqrt(uint16_t n) {
+  uint16_t root = 0;
+  while ((uint32_t)(root + 1) * (root + 1) <= n)
+    root++;
+  return root;
+}
+
+// Fill in the half-width table. A pixel (dx, dy) is inside a circle of radius
+// r if dx^2 + dy^2 <= r^2 + r, which matches the midpoint circle algorithm.
+static void buildTable() {
+  for (int16_t r = 0; r <= DISPLAYCIRCLE_MAX_RADIUS; r++)
+    for (int16_t dy = 0; dy <= r; dy++)
+      halfWidths[TABLE_OFFSET(r) + dy] = isqrt(r * r + r - dy * dy);
+  tableBuilt = true;
+}
+
+// Clamp a radius into the range covered by the table.
+static int16_t clampRadius(int16_t radius) {
+  if (radius > DISPLAYCIRCLE_MAX_RADIUS)
+    return DISPLAYCIRCLE_MAX_RADIUS;
+  return radius;
+}
+
+/***********HEADER FUNCTIONS************/
+
+// Return the half-width of the scanline dy rows from the center of a circle.
+int16_t displayCircle_halfWidth(int16_t radius, int16_t dy) {
+  if (!tableBuilt)
+    buildTable();
+
+  radius = clampRadius(radius);
+  if (dy < 0)
+    dy = -dy;
+  if (radius < 0 || dy > radius)
+    return -1;
+  return halfWidths[TABLE_OFFSET(radius) + dy];
+}
+
+// Fill the ring of pixels outside innerRadius and inside outerRadius.
+void displayCircle_fillAnnulus(int16_t x, int16_t y, int16_t innerRadius,
+                               int16_t outerRadius, uint16_t color) {
+  outerRadius = clampRadius(outerRadius);
+  innerRadius = clampRadius(innerRadius);
+  if (outerRadius < 0 || innerRadius >= outerRadius)
+    return;
+
+  for (int16_t dy = -outerRadius; dy <= outerRadius; dy++) {
+    int16_t outer = displayCircle_halfWidth(outerRadius, dy);
+    int16_t inner = displayCircle_halfWidth(innerRadius, dy);
+
+    if (inner < 0) {
+      // The hole doesn't reach this row, draw the whole scanline
+      display_drawFastHLine(x - outer, y + dy, 2 * outer + 1, color);
+    } else if (outer > inner) {
+      // Draw the part of the scanline on either side of the hole
+      display_drawFastHLine(x - outer, y + dy, outer - inner, color);
+      display_drawFastHLine(x + inner + 1, y + dy, outer - inner, color);
+    }
+  }
+}
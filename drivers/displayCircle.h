@@ -0,0 +1,30 @@
+#ifndef DISPLAYCIRCLE
+#define DISPLAYCIRCLE
+
+#include <stdint.h>
+
+// Largest radius supported by the precomputed scanline tables.
+#define DISPLAYCIRCLE_MAX_RADIUS 32
+
+// Pass as the inner radius to fill the whole disk.
+#define DISPLAYCIRCLE_NO_INNER_RADIUS -1
+
+// Fill the ring of pixels centered on (x, y) that lie outside innerRadius and
+// inside outerRadius, one fast HLine (or two, either side of the hole) per
+// scanline. Use DISPLAYCIRCLE_NO_INNER_RADIUS to fill the whole disk.
+//
+// Growing a filled circle from r0 to r1 only needs
+//   displayCircle_fillAnnulus(x, y, r0, r1, color);
+// and shrinking it from r1 back to r0 only needs
+//   displayCircle_fillAnnulus(x, y, r0, r1, backgroundColor);
+//
+// Radii larger than DISPLAYCIRCLE_MAX_RADIUS are clamped.
+void displayCircle_fillAnnulus(int16_t x, int16_t y, int16_t innerRadius,
+                               int16_t outerRadius, uint16_t color);
+
+// Return the half-width (in pixels, not counting the center pixel) of the
+// scanline dy rows away from the center of a filled circle of the given
+// radius. Returns -1 if the row is outside the circle.
+int16_t displayCircle_halfWidth(int16_t radius, int16_t dy);
+
+#endif /* DISPLAYCIRCLE */
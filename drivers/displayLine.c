@@ -0,0 +1,232 @@
+#include "displayLine.h"
+
+#include <stdlib.h>
+
+#include "display.h"
+
+// A horizontal or vertical run of pixels waiting to be drawn.
+typedef struct {
+  int16_t x;
+  int16_t y;
+  int16_t len;
+  uint16_t color;
+  bool vertical; // true: drawFastVLine, false: drawFastHLine
+  bool erase;    // Erases are drawn before everything else in a flush
+} span_t;
+
+static span_t spans[DISPLAYLINE_BATCH_MAX_SPANS];
+static uint16_t spanCount;
+static bool batching = false;
+
+/***********HELPER FUNCTIONS************/
+
+// Draw a single span right now.
+static void drawSpan(const span_t *s) {
+  if (s->vertical)
+    display_drawFastVLine(s->x, s->y, s->len, s->color);
+  else
+    display_drawFastHLine(s->x, s->y, s->len, s->color);
+}
+
+// Orders spans by erase first, then orientation and color (so runs that could
+// merge end up next to each other), then row/column.
+static int compareSpans(const void *a, const void *b) {
+  const span_t *s1 = a;
+  const span_t *s2 = b;
+
+  if (s1->erase != s2->erase)
+    return s1->erase ? -1 : 1;
+  if (s1->vertical != s2->vertical)
+    return s1->vertical - s2->vertical;
+  if (s1->color != s2->color)
+    return s1->color - s2->color;
+
+  // Horizontal spans sort by row then column, vertical by column then row
+  int16_t major1 = s1->vertical ? s1->x : s1->y;
+  int16_t major2 = s2->vertical ? s2->x : s2->y;
+  if (major1 != major2)
+    return major1 - major2;
+  int16_t minor1 = s1->vertical ? s1->y : s1->x;
+  int16_t minor2 = s2->vertical ? s2->y : s2->x;
+  return minor1 - minor2;
+}
+
+// Returns whether b continues (or overlaps) a, so the two can be one write.
+// Assumes a sorts before b.
+static bool spansTouch(const span_t *a, const span_t *b) {
+  if (a->erase != b->erase || a->vertical != b->vertical ||
+      a->color != b->color)
+    return false;
+  if (a->vertical)
+    return a->x == b->x && b->y <= a->y + a->len;
+  return a->y == b->y && b->x <= a->x + a->len;
+}
+
+// Queue a span when batching, otherwise draw it immediately.
+static void emitSpan(int16_t x, int16_t y, int16_t len, bool vertical,
+                     uint16_t color, bool erase) {
+  span_t s = {x, y, len, color, vertical, erase};
+
+  if (!batching) {
+    drawSpan(&s);
+    return;
+  }
+
+  if (spanCount == DISPLAYLINE_BATCH_MAX_SPANS)
+    displayLine_batchFlush();
+  spans[spanCount++] = s;
+}
+
+// Walk n pixels of a line starting from the position stored in *line, emitting
+// the pixels as runs in the given color. The position in *line is advanced.
+static void walk(displayLine_t *line, uint16_t n, uint16_t color, bool erase) {
+  int16_t dx = abs(line->x1 - line->x0);
+  int16_t dy = -abs(line->y1 - line->y0);
+  int16_t sx = line->x0 < line->x1 ? 1 : -1;
+  int16_t sy = line->y0 < line->y1 ? 1 : -1;
+  bool steep = -dy > dx;
+
+  // Current run of pixels along the major axis
+  int16_t runX = line->x;
+  int16_t runY = line->y;
+  int16_t runLen = 0;
+
+  for (uint16_t i = 0; i < n; i++) {
+    // Start a new run whenever the minor axis coordinate changes
+    if (runLen && (steep ? line->x != runX : line->y != runY)) {
+      // Runs are emitted from their lowest coordinate
+      if (steep)
+        emitSpan(runX, sy > 0 ? runY : runY - runLen + 1, runLen, true, color,
+                 erase);
+      else
+        emitSpan(sx > 0 ? runX : runX - runLen + 1, runY, runLen, false, color,
+                 erase);
+      runLen = 0;
+    }
+    if (!runLen) {
+      runX = line->x;
+      runY = line->y;
+    }
+    runLen++;
+
+    // Step to the next pixel
+    int16_t e2 = 2 * line->err;
+    if (e2 >= dy) {
+      line->err += dy;
+      line->x += sx;
+    }
+    if (e2 <= dx) {
+      line->err += dx;
+      line->y += sy;
+    }
+  }
+
+  // Emit the last run
+  if (runLen) {
+    if (steep)
+      emitSpan(runX, sy > 0 ? runY : runY - runLen + 1, runLen, true, color,
+               erase);
+    else
+      emitSpan(sx > 0 ? runX : runX - runLen + 1, runY, runLen, false, color,
+               erase);
+  }
+}
+
+// Move the line's position back to its start point.
+static void rewindLine(displayLine_t *line) {
+  line->x = line->x0;
+  line->y = line->y0;
+  line->err = abs(line->x1 - line->x0) - abs(line->y1 - line->y0);
+  line->drawn = 0;
+}
+
+/***********HEADER FUNCTIONS************/
+
+// Initialize a line from (x0, y0) to (x1, y1). Nothing is drawn.
+void displayLine_init(displayLine_t *line, int16_t x0, int16_t y0, int16_t x1,
+                      int16_t y1) {
+  line->x0 = x0;
+  line->y0 = y0;
+  line->x1 = x1;
+  line->y1 = y1;
+
+  // Bresenham draws one pixel per step along the major axis
+  int16_t dx = abs(x1 - x0);
+  int16_t dy = abs(y1 - y0);
+  line->length = (dx > dy ? dx : dy) + 1;
+
+  rewindLine(line);
+}
+
+// Extend the drawn part of the line up to the point (x, y), drawing only the
+// new pixels.
+void displayLine_extendTo(displayLine_t *line, int16_t x, int16_t y,
+                          uint16_t color) {
+  bool steep = abs(line->y1 - line->y0) > abs(line->x1 - line->x0);
+
+  // Distance along the major axis from the start point to the target
+  int32_t target = steep ? abs(y - line->y0) : abs(x - line->x0);
+  // Pixels needed to cover the target, including the start pixel
+  int32_t needed = target + 1;
+  if (needed > line->length)
+    needed = line->length;
+  if (needed <= line->drawn)
+    return;
+
+  walk(line, needed - line->drawn, color, false);
+  line->drawn = needed;
+}
+
+// Erase the drawn part of the line and rewind it to its start point.
+void displayLine_erase(displayLine_t *line, uint16_t bgColor) {
+  uint16_t drawn = line->drawn;
+
+  // Walk the same pixels again in the background color
+  rewindLine(line);
+  walk(line, drawn, bgColor, true);
+  rewindLine(line);
+}
+
+// Return whether every pixel of the line has been drawn.
+bool displayLine_isComplete(displayLine_t *line) {
+  return line->drawn == line->length;
+}
+
+// Start batching line runs.
+void displayLine_batchBegin() {
+  spanCount = 0;
+  batching = true;
+}
+
+// Draw everything queued so far, but keep batching.
+void displayLine_batchFlush() {
+  if (!spanCount)
+    return;
+
+  qsort(spans, spanCount, sizeof(span_t), compareSpans);
+
+  // Merge runs that touch into a single write
+  span_t current = spans[0];
+  for (uint16_t i = 1; i < spanCount; i++) {
+    if (spansTouch(&current, &spans[i])) {
+      int16_t currentEnd = (current.vertical ? current.y : current.x) +
+                           current.len;
+      int16_t nextEnd = (spans[i].vertical ? spans[i].y : spans[i].x) +
+                        spans[i].len;
+      if (nextEnd > currentEnd)
+        current.len += nextEnd - currentEnd;
+    } else {
+      drawSpan(&current);
+      current = spans[i];
+    }
+  }
+  drawSpan(&current);
+
+  spanCount = 0;
+}
+
+// Draw everything queued so far and stop batching.
+void displayLine_batchEnd() {
+  displayLine_batchFlush();
+  batching = false;
+}
@@ -0,0 +1,58 @@
+#ifndef DISPLAYLINE
+#define DISPLAYLINE
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Maximum number of spans queued while batching before an early flush.
+#define DISPLAYLINE_BATCH_MAX_SPANS 256
+
+// An incremental line. The line is walked with Bresenham's algorithm from its
+// start point towards its end point, and each call to displayLine_extendTo()
+// only draws the pixels that have not been drawn yet. Consecutive pixels are
+// coalesced into horizontal (shallow lines) or vertical (steep lines) runs and
+// drawn with the fast HLine/VLine display calls.
+typedef struct {
+  int16_t x0;      // Start point of the line
+  int16_t y0;      // Start point of the line
+  int16_t x1;      // End point of the line
+  int16_t y1;      // End point of the line
+  int16_t x;       // Next pixel to be drawn
+  int16_t y;       // Next pixel to be drawn
+  int16_t err;     // Bresenham error term for the next pixel
+  uint16_t drawn;  // Number of pixels drawn so far
+  uint16_t length; // Total number of pixels in the line
+} displayLine_t;
+
+// Initialize a line from (x0, y0) to (x1, y1). Nothing is drawn.
+void displayLine_init(displayLine_t *line, int16_t x0, int16_t y0, int16_t x1,
+                      int16_t y1);
+
+// Extend the drawn part of the line up to the point (x, y), drawing only the
+// new pixels. (x, y) is expected to lie (roughly) on the line; only its
+// coordinate along the line's major axis is used. Points behind what has
+// already been drawn draw nothing, and points past the end are clamped.
+void displayLine_extendTo(displayLine_t *line, int16_t x, int16_t y,
+                          uint16_t color);
+
+// Erase the drawn part of the line by redrawing the same pixels in the given
+// background color, and rewind the line back to its start point.
+void displayLine_erase(displayLine_t *line, uint16_t bgColor);
+
+// Return whether every pixel of the line has been drawn.
+bool displayLine_isComplete(displayLine_t *line);
+
+// Start batching. Until displayLine_batchEnd() is called, line runs are queued
+// instead of drawn. On flush, the queued runs are sorted so that erases are
+// drawn before new pixels, then by row/column, and runs that touch are merged
+// into a single HLine/VLine write.
+void displayLine_batchBegin();
+
+// Draw everything queued so far, but keep batching. Call this before drawing
+// anything that must appear on top of the queued lines.
+void displayLine_batchFlush();
+
+// Draw everything queued so far and stop batching.
+void displayLine_batchEnd();
+
+#endif /* DISPLAYLINE */
@@ -0,0 +1,210 @@
+#include "framePacer.h"
+
+#include <stdio.h>
+
+#include "idle.h"
+#include "timestamp.h"
+
+// Weight given to the newest sample in the running render cost average.
+#define RENDER_COST_SMOOTHING 0.125
+
+// Width of a histogram bin, as a fraction of the tick period.
+#define BIN_WIDTH_FRACTION 0.25
+
+#define SECONDS_TO_MS 1000.0
+
+// Ticks are counted by the ISR and consumed by the main loop. Each counter only
+// has a single writer, so pending ticks can be read without disabling
+// interrupts.
+static volatile uint32_t ticksRaised;
+static uint32_t ticksSimulated;
+
+static double tickPeriod;
+
+// Current frame/render measurements
+static double frameStartTime;
+static double renderStartTime;
+static bool frameStarted;
+static uint32_t frameTicks;
+
+// Adaptive render scheduling
+static double renderCostAverage;
+static uint16_t framesSinceRender;
+static uint16_t deferredInARow;
+
+// Statistics
+static uint32_t frameCount;
+static uint32_t renderCount;
+static uint32_t deferredBehindCount;
+static uint32_t deferredBudgetCount;
+static uint32_t maxTicksPerFrame;
+static double updateTimeTotal;
+static double updateTimeMax;
+static double renderTimeTotal;
+static double renderTimeMax;
+static uint32_t frameHistogram[FRAMEPACER_HISTOGRAM_BINS];
+static uint32_t renderHistogram[FRAMEPACER_HISTOGRAM_BINS];
+
+/***********HELPER FUNCTIONS************/
+
+// Current time, in seconds.
+static double now() { return timestamp_toSeconds(timestamp_now()); }
+
+// True if the ISR has raised a tick the main loop hasn't simulated.
+static bool ticksPending() { return ticksRaised != ticksSimulated; }
+
+// Add a duration to a histogram.
+static void addToHistogram(uint32_t histogram[], double seconds) {
+  uint32_t bin = seconds / (tickPeriod * BIN_WIDTH_FRACTION);
+  if (bin >= FRAMEPACER_HISTOGRAM_BINS)
+    bin = FRAMEPACER_HISTOGRAM_BINS - 1;
+  histogram[bin]++;
+}
+
+// Print a histogram, one line per bin, with the bin's range in ms.
+static void printHistogram(const char *name, uint32_t histogram[]) {
+  double binWidthMs = tickPeriod * BIN_WIDTH_FRACTION * SECONDS_TO_MS;
+
+  printf("%s:\n", name);
+  for (uint16_t i = 0; i < FRAMEPACER_HISTOGRAM_BINS; i++) {
+    if (i == FRAMEPACER_HISTOGRAM_BINS - 1)
+      printf("  >= %6.2f ms        : %lu\n", i * binWidthMs,
+             (unsigned long)histogram[i]);
+    else
+      printf("  %6.2f - %6.2f ms : %lu\n", i * binWidthMs, (i + 1) * binWidthMs,
+             (unsigned long)histogram[i]);
+  }
+}
+
+// Number of frames each render should cover, given the measured render cost.
+static uint16_t getRenderInterval() {
+  uint16_t interval =
+      1 + renderCostAverage / (tickPeriod * FRAMEPACER_RENDER_BUDGET_FRACTION);
+  if (interval > FRAMEPACER_MAX_DEFERRED_RENDERS + 1)
+    interval = FRAMEPACER_MAX_DEFERRED_RENDERS + 1;
+  return interval;
+}
+
+/***********HEADER FUNCTIONS************/
+
+// Initialize the frame pacer for a simulation tick of the given period.
+void framePacer_init(double tickPeriodSeconds) {
+  tickPeriod = tickPeriodSeconds;
+  timestamp_init();
+
+  ticksRaised = 0;
+  ticksSimulated = 0;
+  frameStarted = false;
+  renderCostAverage = 0.0;
+  framesSinceRender = 0;
+  deferredInARow = 0;
+
+  frameCount = 0;
+  renderCount = 0;
+  deferredBehindCount = 0;
+  deferredBudgetCount = 0;
+  maxTicksPerFrame = 0;
+  updateTimeTotal = 0.0;
+  updateTimeMax = 0.0;
+  renderTimeTotal = 0.0;
+  renderTimeMax = 0.0;
+  for (uint16_t i = 0; i < FRAMEPACER_HISTOGRAM_BINS; i++) {
+    frameHistogram[i] = 0;
+    renderHistogram[i] = 0;
+  }
+}
+
+// Call this from the simulation timer's ISR, once per tick.
+void framePacer_tickIsr() { ticksRaised++; }
+
+// Return the number of ticks that have been raised since init.
+uint32_t framePacer_getTickCount() { return ticksRaised; }
+
+// Wait until at least one tick is pending, then return the number of pending
+// ticks.
+uint32_t framePacer_waitForTicks() {
+  // Close out the previous frame
+  if (frameStarted)
+    addToHistogram(frameHistogram, now() - frameStartTime);
+
+  // Sleep until the next tick instead of spinning
+  idle_waitUntil(ticksPending);
+
+  frameStartTime = now();
+  frameStarted = true;
+  frameCount++;
+
+  // Take every tick that is pending, they are all simulated this frame
+  frameTicks = ticksRaised - ticksSimulated;
+  ticksSimulated += frameTicks;
+  if (frameTicks > maxTicksPerFrame)
+    maxTicksPerFrame = frameTicks;
+  return frameTicks;
+}
+
+// Returns true if the caller should render this frame.
+bool framePacer_beginRender() {
+  // The simulation updates ran between the end of the wait and now
+  double updateTime = now() - frameStartTime;
+  updateTimeTotal += updateTime;
+  if (updateTime / frameTicks > updateTimeMax)
+    updateTimeMax = updateTime / frameTicks;
+
+  framesSinceRender++;
+
+  if (deferredInARow < FRAMEPACER_MAX_DEFERRED_RENDERS) {
+    // Catch up on the simulation first if a tick arrived during the update
+    if (ticksRaised != ticksSimulated) {
+      deferredBehindCount++;
+      deferredInARow++;
+      return false;
+    }
+
+    // Coalesce renders over several frames if they don't fit in the budget
+    if (framesSinceRender < getRenderInterval()) {
+      deferredBudgetCount++;
+      deferredInARow++;
+      return false;
+    }
+  }
+
+  framesSinceRender = 0;
+  deferredInARow = 0;
+  renderStartTime = now();
+  return true;
+}
+
+// Mark the end of a render started with framePacer_beginRender().
+void framePacer_endRender() {
+  double renderTime = now() - renderStartTime;
+
+  renderCount++;
+  renderTimeTotal += renderTime;
+  if (renderTime > renderTimeMax)
+    renderTimeMax = renderTime;
+  renderCostAverage += (renderTime - renderCostAverage) * RENDER_COST_SMOOTHING;
+  addToHistogram(renderHistogram, renderTime);
+}
+
+// Print tick, render and deferral counts along with the histograms.
+void framePacer_printStats() {
+  printf("Simulated %lu of %lu ticks (%lu pending)\n",
+         (unsigned long)ticksSimulated, (unsigned long)ticksRaised,
+         (unsigned long)(ticksRaised - ticksSimulated));
+  printf("Frames: %lu, most ticks in one frame: %lu\n",
+         (unsigned long)frameCount, (unsigned long)maxTicksPerFrame);
+  printf("Renders: %lu, deferred while behind: %lu, coalesced for budget: "
+         "%lu\n",
+         (unsigned long)renderCount, (unsigned long)deferredBehindCount,
+         (unsigned long)deferredBudgetCount);
+  if (ticksSimulated)
+    printf("Update time: average %.3f ms per tick, max %.3f ms per tick\n",
+           updateTimeTotal / ticksSimulated * SECONDS_TO_MS,
+           updateTimeMax * SECONDS_TO_MS);
+  if (renderCount)
+    printf("Render time: average %.3f ms, max %.3f ms\n",
+           renderTimeTotal / renderCount * SECONDS_TO_MS,
+           renderTimeMax * SECONDS_TO_MS);
+  printHistogram("Frame time (update + render)", frameHistogram);
+  printHistogram("Render time", renderHistogram);
+}
@@ -0,0 +1,67 @@
+#ifndef FRAMEPACER
+#define FRAMEPACER
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Number of bins in the frame-time and render-time histograms. Each bin is a
+// quarter of a tick period wide, the last bin collects everything longer.
+#define FRAMEPACER_HISTOGRAM_BINS 12
+
+// Renders are never deferred more than this many frames in a row, so the
+// screen keeps up even when the game is running behind.
+#define FRAMEPACER_MAX_DEFERRED_RENDERS 4
+
+// Fraction of a tick period that rendering may take before renders start to
+// be coalesced over several ticks.
+#define FRAMEPACER_RENDER_BUDGET_FRACTION 0.5
+
+// The frame pacer separates a game's fixed-rate simulation from its rendering.
+// The timer ISR only counts ticks, so no tick is ever dropped: the main loop
+// runs one simulation update per tick, and renders once per loop iteration
+// (a frame) unless rendering is being deferred. Rendering is deferred while
+// the simulation is behind, and coalesced over several ticks when the measured
+// render cost doesn't fit in the render budget.
+//
+// Typical main loop:
+//   while (...) {
+//     uint32_t ticks = framePacer_waitForTicks();
+//     for (uint32_t i = 0; i < ticks; i++)
+//       game_update();
+//     if (framePacer_beginRender()) {
+//       game_render();
+//       framePacer_endRender();
+//     }
+//   }
+//   framePacer_printStats();
+
+// Initialize the frame pacer for a simulation tick of the given period. Frame
+// and render times are measured with timestamp.h.
+void framePacer_init(double tickPeriodSeconds);
+
+// Call this from the simulation timer's ISR, once per tick.
+void framePacer_tickIsr();
+
+// Return the number of ticks that have been raised since init.
+uint32_t framePacer_getTickCount();
+
+// Wait until at least one tick is pending, then return the number of pending
+// ticks. The caller must run exactly that many simulation updates. The CPU
+// sleeps while it waits (see idle.h).
+uint32_t framePacer_waitForTicks();
+
+// Call once per frame, after the simulation updates (this also marks the end of
+// the update phase for timing). Returns true if the caller should render this
+// frame, in which case framePacer_endRender() must be called once the render is
+// done. Returns false if the render is deferred; the next render will catch up
+// on everything.
+bool framePacer_beginRender();
+
+// Mark the end of a render started with framePacer_beginRender().
+void framePacer_endRender();
+
+// Print tick, render and deferral counts, the average update (tick) and render
+// times, and frame-time and render-time histograms.
+void framePacer_printStats();
+
+#endif /* FRAMEPACER */
@@ -0,0 +1,90 @@
+#include "idle.h"
+
+#include <stdio.h>
+#ifdef ZYBO_BOARD
+#include "armInterrupts.h"
+#elif defined(HEADLESS)
+#include <time.h>
+
+#include "headless.h"
+#else
+#include "utils.h"
+#endif
+
+#define SECONDS_TO_NS 1.0E9
+#define PERCENT 100.0
+
+static timestamp_t idleTime;
+static timestamp_t statsStart;
+static uint32_t wakeupCount;
+
+/***********HELPER FUNCTIONS************/
+
+// Sleep until the next interrupt (or event, on the host) and add the time to
+// the idle time.
+static void goToSleep() {
+  timestamp_t start = timestamp_now();
+#ifdef ZYBO_BOARD
+  // Make sure every earlier memory access is done before the core stops
+  __asm__ volatile("dsb\n\twfi" ::: "memory");
+#elif defined(HEADLESS)
+  // Jump straight to the next timer interrupt in virtual time. With no timer
+  // running, time can't move, so just let the host do something else.
+  if (!headless_runToNextEvent()) {
+    struct timespec sleepTime = {0, IDLE_HOST_SLEEP_SECONDS * SECONDS_TO_NS};
+    nanosleep(&sleepTime, NULL);
+  }
+#else
+  utils_sleep();
+#endif
+  idleTime += timestamp_now() - start;
+  wakeupCount++;
+}
+
+/***********HEADER FUNCTIONS************/
+
+// Sleep until the next interrupt.
+void idle_wait() { goToSleep(); }
+
+// Sleep until ready() returns true.
+void idle_waitUntil(bool (*ready)()) {
+  while (true) {
+#ifdef ZYBO_BOARD
+    // A masked interrupt still wakes the core from WFI; it is taken as soon as
+    // interrupts are enabled again
+    armInterrupts_disable();
+    if (ready()) {
+      armInterrupts_enable();
+      return;
+    }
+    goToSleep();
+    armInterrupts_enable();
+#else
+    if (ready())
+      return;
+    goToSleep();
+#endif
+  }
+}
+
+// Clear the idle time and the wakeup count.
+void idle_resetStats() {
+  timestamp_init();
+  idleTime = 0;
+  wakeupCount = 0;
+  statsStart = timestamp_now();
+}
+
+// Return the time spent asleep since the last reset.
+timestamp_t idle_getIdleTime() { return idleTime; }
+
+// Return the number of wakeups since the last reset.
+uint32_t idle_getWakeupCount() { return wakeupCount; }
+
+// Print the share of the time since the last reset spent asleep.
+void idle_printStats() {
+  timestamp_t total = timestamp_now() - statsStart;
+  printf("Idle: %.1f%% of %.2f s, %lu wakeups\n",
+         total ? (double)idleTime / total * PERCENT : 0.0,
+         timestamp_toSeconds(total), (unsigned long)wakeupCount);
+}
@@ -0,0 +1,43 @@
+#ifndef IDLE
+#define IDLE
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "timestamp.h"
+
+// The headless build skips virtual time ahead to the next timer interrupt
+// instead of waiting for it (see headless.h), and only sleeps this long if no
+// timer is running. The emulator sleeps in utils_sleep() instead, which
+// returns on the next emulated event.
+#define IDLE_HOST_SLEEP_SECONDS 100.0E-6
+
+// Put the CPU to sleep until the next interrupt (WFI on the board). Any
+// interrupt wakes it, so check whatever you are waiting for again after this
+// returns, and only call it when some interrupt is sure to come.
+void idle_wait();
+
+// Sleep until ready() returns true, waking on every interrupt to check it
+// again. Use this in place of a busy-wait on a flag set by an ISR. On the board
+// ready() is called with interrupts masked, so an interrupt that makes it true
+// just before the CPU goes to sleep still wakes it (WFI returns on a pending
+// interrupt), and the wait ends as soon as that interrupt has been handled.
+// Keep ready() short, and only call this with interrupts enabled.
+void idle_waitUntil(bool (*ready)());
+
+// Clear the idle time and the wakeup count, and start measuring from now.
+void idle_resetStats();
+
+// Return the time spent asleep in idle_wait() since the last reset, in ticks
+// (see timestamp.h).
+timestamp_t idle_getIdleTime();
+
+// Return the number of times the CPU woke up from idle_wait() and
+// idle_waitUntil() since the last reset.
+uint32_t idle_getWakeupCount();
+
+// Print the share of the time since the last reset spent asleep, and the
+// number of wakeups.
+void idle_printStats();
+
+#endif /* IDLE */
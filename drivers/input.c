@@ -0,0 +1,152 @@
+#include "input.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+#include "buttons.h"
+#include "switches.h"
+
+#define QUEUE_INDEX_MASK (INPUT_EVENT_QUEUE_SIZE - 1)
+
+// Integrator for each input: counts up on every tick it reads pressed and down
+// on every tick it reads released, saturating at 0 and debounceTicks. The
+// debounced state only changes when the integrator reaches either end.
+static uint8_t integrators[INPUT_COUNT];
+static uint32_t state;
+
+// Ticks each repeating input has been held down since it was pressed
+static uint32_t heldTicks[INPUT_COUNT];
+
+// Tick counts converted from the periods in input.h
+static uint8_t debounceTicks;
+static uint32_t holdTicks;
+static uint32_t repeatTicks;
+
+static bool (*triggerReader)();
+
+// Event queue. The tick is the only writer of tail and the reader the only
+// writer of head, so neither side needs to disable interrupts.
+static input_event_t events[INPUT_EVENT_QUEUE_SIZE];
+static volatile uint32_t eventHead;
+static volatile uint32_t eventTail;
+static uint32_t droppedEvents;
+
+/***********HELPER FUNCTIONS************/
+
+// Convert a period to a whole number of ticks, at least one.
+static uint32_t toTicks(double seconds, double period_seconds) {
+  uint32_t ticks = ceil(seconds / period_seconds);
+  return ticks ? ticks : 1;
+}
+
+// Read every input once, raw.
+static uint32_t readRaw() {
+  uint32_t raw = buttons_read() & INPUT_BUTTONS_MASK;
+  raw |= (switches_read() << INPUT_SWITCHES_SHIFT) & INPUT_SWITCHES_MASK;
+  if (triggerReader && triggerReader())
+    raw |= INPUT_MASK(INPUT_TRIGGER);
+  return raw;
+}
+
+// Add an event to the queue.
+static void postEvent(uint8_t input, input_event_type_t type, timestamp_t now) {
+  if (eventTail - eventHead == INPUT_EVENT_QUEUE_SIZE) {
+    droppedEvents++;
+    return;
+  }
+  input_event_t *event = &events[eventTail & QUEUE_INDEX_MASK];
+  event->input = input;
+  event->type = type;
+  event->time = now;
+
+  // Publish the event only once it has been written
+  atomic_thread_fence(memory_order_release);
+  eventTail++;
+}
+
+// Report hold and repeat events for a repeating input that is still down.
+static void updateHeld(uint8_t input, timestamp_t now) {
+  uint32_t held = ++heldTicks[input];
+  if (held == holdTicks)
+    postEvent(input, INPUT_EVENT_HOLD, now);
+  else if (held > holdTicks && (held - holdTicks) % repeatTicks == 0)
+    postEvent(input, INPUT_EVENT_REPEAT, now);
+}
+
+/***********HEADER FUNCTIONS************/
+
+// Initialize the buttons, switches and input layer.
+void input_init(double period_seconds) {
+  buttons_init();
+  switches_init();
+  timestamp_init();
+
+  debounceTicks = toTicks(INPUT_DEBOUNCE_SECONDS, period_seconds);
+  holdTicks = toTicks(INPUT_HOLD_SECONDS, period_seconds);
+  repeatTicks = toTicks(INPUT_REPEAT_SECONDS, period_seconds);
+
+  for (uint8_t i = 0; i < INPUT_COUNT; i++) {
+    integrators[i] = 0;
+    heldTicks[i] = 0;
+  }
+  state = 0;
+  triggerReader = NULL;
+  eventHead = 0;
+  eventTail = 0;
+  droppedEvents = 0;
+}
+
+// Read the trigger with this function on every tick.
+void input_setTriggerReader(bool (*isPressed)()) { triggerReader = isPressed; }
+
+// Sample every input, debounce, and queue the resulting events.
+void input_tick() {
+  uint32_t raw = readRaw();
+  timestamp_t now = timestamp_now();
+
+  for (uint8_t i = 0; i < INPUT_COUNT; i++) {
+    uint32_t mask = INPUT_MASK(i);
+    if (raw & mask) {
+      if (integrators[i] < debounceTicks)
+        integrators[i]++;
+    } else if (integrators[i] > 0) {
+      integrators[i]--;
+    }
+
+    if (!(state & mask) && integrators[i] == debounceTicks) {
+      state |= mask;
+      heldTicks[i] = 0;
+      postEvent(i, INPUT_EVENT_PRESS, now);
+    } else if ((state & mask) && integrators[i] == 0) {
+      state &= ~mask;
+      postEvent(i, INPUT_EVENT_RELEASE, now);
+    } else if ((state & mask) && (mask & INPUT_REPEATING_MASK)) {
+      updateHeld(i, now);
+    }
+  }
+}
+
+// Take the oldest event from the event queue.
+bool input_getEvent(input_event_t *event) {
+  if (eventHead == eventTail)
+    return false;
+  atomic_thread_fence(memory_order_acquire);
+  *event = events[eventHead & QUEUE_INDEX_MASK];
+
+  // Finish reading the slot before handing it back to the ISR
+  atomic_thread_fence(memory_order_release);
+  eventHead++;
+  return true;
+}
+
+// Return the debounced state of every input.
+uint32_t input_getState() { return state; }
+
+// Return the debounced switch settings.
+uint8_t input_getSwitches() {
+  return (state & INPUT_SWITCHES_MASK) >> INPUT_SWITCHES_SHIFT;
+}
+
+// Return the number of events dropped because the queue was full.
+uint32_t input_getDroppedEventCount() { return droppedEvents; }
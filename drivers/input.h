@@ -0,0 +1,89 @@
+#ifndef INPUT
+#define INPUT
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "timestamp.h"
+
+// Inputs, as bit numbers in the masks below. The buttons and switches keep the
+// bit positions buttons_read() and switches_read() give them.
+#define INPUT_BTN0 0
+#define INPUT_BTN1 1
+#define INPUT_BTN2 2
+#define INPUT_BTN3 3
+#define INPUT_SW0 4
+#define INPUT_SW1 5
+#define INPUT_SW2 6
+#define INPUT_SW3 7
+#define INPUT_TRIGGER 8
+#define INPUT_COUNT 9
+
+#define INPUT_MASK(input) (1UL << (input))
+#define INPUT_BUTTONS_MASK 0x00F
+#define INPUT_SWITCHES_MASK 0x0F0
+#define INPUT_SWITCHES_SHIFT 4
+
+// Inputs that report hold and repeat events. Switches stay where they are put,
+// so they only report presses (switched on) and releases (switched off).
+#define INPUT_REPEATING_MASK (INPUT_BUTTONS_MASK | INPUT_MASK(INPUT_TRIGGER))
+
+// An input has to read the same for this long before a change is reported
+#define INPUT_DEBOUNCE_SECONDS 0.02
+
+// A button held this long reports a hold event, then a repeat event every
+// repeat period for as long as it stays down
+#define INPUT_HOLD_SECONDS 0.5
+#define INPUT_REPEAT_SECONDS 0.1
+
+// Number of events that can wait in the queue (a power of two)
+#define INPUT_EVENT_QUEUE_SIZE 32
+
+// Kind of input event
+typedef enum {
+  INPUT_EVENT_PRESS,   // Pressed (or switched on)
+  INPUT_EVENT_RELEASE, // Released (or switched off)
+  INPUT_EVENT_HOLD,    // Held down for INPUT_HOLD_SECONDS
+  INPUT_EVENT_REPEAT   // Still held down, every INPUT_REPEAT_SECONDS after that
+} input_event_type_t;
+
+// An input event: which input, what happened to it and when it was seen
+typedef struct {
+  uint8_t input;
+  input_event_type_t type;
+  timestamp_t time;
+} input_event_t;
+
+// The input layer samples the buttons, the switches and (if there is one) the
+// gun trigger from a single periodic tick, debounces every input with an
+// integrator, and queues an event for every debounced change. The tick is
+// usually run from a timer callback and the events taken by the game loop, so
+// the loop never reads the GPIO registers itself.
+
+// Initialize the buttons and switches, and the input layer for a tick of the
+// given period (in seconds). Every input starts out released, so a switch that
+// is already on reports a press once it has been debounced.
+void input_init(double period_seconds);
+
+// Read the trigger with this function on every tick. The trigger pin is not
+// part of the drivers, so whoever owns it supplies the reader, after
+// input_init(); until then the trigger reads as released.
+void input_setTriggerReader(bool (*isPressed)());
+
+// Sample every input, debounce, and queue the resulting events.
+void input_tick();
+
+// Take the oldest event from the event queue. Returns false if there is none.
+// Events are dropped if the queue is full.
+bool input_getEvent(input_event_t *event);
+
+// Return the debounced state of every input, one bit each (see INPUT_MASK()).
+uint32_t input_getState();
+
+// Return the debounced switch settings in the form switches_read() uses.
+uint8_t input_getSwitches();
+
+// Return the number of events dropped because the queue was full.
+uint32_t input_getDroppedEventCount();
+
+#endif /* INPUT */
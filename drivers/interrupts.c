@@ -1,8 +1,11 @@
 #include "interrupts.h"
 #include "armInterrupts.h"
-#include "intervalTimer.h"
+#include "timestamp.h"
 #include "xil_io.h"
 #include "xparameters.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
 
 // Defining offsets for the relevant interrupt controller addresses
 #define IPR_BASE_OFFSET 0x04 // Interrupt Pending Register
@@ -16,13 +19,34 @@
 #define MER_ME_MASK 0x1  // Master IRQ Enable
 #define MER_HIE_MASK 0x2 // Hardware Interrupt Enable
 
+// Priority of the code running when no handler is running
+#define NO_PRIORITY -1
+
 // Global array of user-provided interrupt service routines
 #define NUM_INTR_INPUTS XPAR_AXI_INTC_0_NUM_INTR_INPUTS
 static void (*isrFcnPtrs[NUM_INTR_INPUTS])() = {NULL};
+static uint8_t priorities[NUM_INTR_INPUTS];
+
+// Lines at each priority level that are enabled and have a handler, so that
+// the dispatcher only has to mask the pending register to find what to run
+static uint32_t levelMasks[INTERRUPTS_PRIORITY_LEVELS];
+static uint32_t enabledLines;
+
+// Priority of the handler currently running
+static int8_t currentPriority = NO_PRIORITY;
+
+// Per-line statistics, only kept once interrupts_enableStats() is called
+static bool statsEnabled;
+static timestamp_t dispatchStart;
+static uint32_t invocationCounts[NUM_INTR_INPUTS];
+static timestamp_stat_t latencyStats[NUM_INTR_INPUTS];
+static timestamp_stat_t handlerStats[NUM_INTR_INPUTS];
 
 // Declare some helper functions
 static uint32_t readRegister(uint32_t offset);
 static void writeRegister(uint32_t offset, uint32_t value);
+static void updateLevelMasks();
+static void dispatch(int8_t abovePriority);
 static void interrupts_isr();
 
 /***********HEADER FUNCTIONS************/
@@ -59,18 +83,72 @@ void interrupts_init() {
 void interrupts_register(uint8_t irq, void (*fcn)()) {
   // Add function pointer to the array of ISR pointers
   isrFcnPtrs[irq] = fcn;
+  updateLevelMasks();
 }
 
 // Enables single input interrupt line, given by irq number.
 void interrupts_irq_enable(uint8_t irq) {
   // Enable the specified interrupt input
   writeRegister(SIE_BASE_OFFSET, 1 << irq);
+  enabledLines |= 1 << irq;
+  updateLevelMasks();
 }
 
 // Disable single input interrupt line, given by irq number.
 void interrupts_irq_disable(uint8_t irq) {
   // Enable the specified interrupt input
   writeRegister(CIE_BASE_OFFSET, 1 << irq);
+  enabledLines &= ~(1 << irq);
+  updateLevelMasks();
+}
+
+// Set the priority of an input line (0 to INTERRUPTS_PRIORITY_LEVELS - 1).
+void interrupts_setPriority(uint8_t irq, uint8_t priority) {
+  if (priority >= INTERRUPTS_PRIORITY_LEVELS) {
+    printf("interrupts_setPriority: priority %d is out of range\n", priority);
+    assert(false);
+  }
+  priorities[irq] = priority;
+  updateLevelMasks();
+}
+
+// Handle any pending lines above the priority of the running handler, nested
+// inside it.
+void interrupts_runHigherPriority() {
+  if (currentPriority == NO_PRIORITY)
+    return;
+  dispatch(currentPriority);
+}
+
+// Start counting invocations and timing the handler of every line.
+void interrupts_enableStats() {
+  timestamp_init();
+  for (uint8_t i = 0; i < NUM_INTR_INPUTS; i++) {
+    invocationCounts[i] = 0;
+    latencyStats[i] = (timestamp_stat_t){0};
+    handlerStats[i] = (timestamp_stat_t){0};
+  }
+  statsEnabled = true;
+}
+
+// Return the number of times the handler for a line has been called.
+uint32_t interrupts_getInvocationCount(uint8_t irq) {
+  return invocationCounts[irq];
+}
+
+// Print the priority, invocation count, latency and handler time of every line
+// that has been handled.
+void interrupts_printStats() {
+  for (uint8_t i = 0; i < NUM_INTR_INPUTS; i++) {
+    if (!invocationCounts[i])
+      continue;
+    printf("IRQ %d (priority %d): %lu calls\n", i, priorities[i],
+           (unsigned long)invocationCounts[i]);
+    if (!statsEnabled)
+      continue;
+    timestamp_printStat("  Latency", &latencyStats[i]);
+    timestamp_printStat("  Handler time", &handlerStats[i]);
+  }
 }
 
 /***********HELPER FUNCTIONS************/
@@ -87,23 +165,78 @@ static void writeRegister(uint32_t offset, uint32_t value) {
   Xil_Out32(XPAR_AXI_INTC_0_BASEADDR + offset, value);
 }
 
-// Checks for interrupts and calls appropriate interrupt
-// service routines given by the user
-static void interrupts_isr() {
-  // Loop through each interrupt input and check if
-  // there is an interrupt pending
-  for (uint32_t i = 0; i < NUM_INTR_INPUTS; i++) {
-    // Read IPR to check if there is a pending interrupt
-    // for the current iqr number
-    bool pendingIntr = readRegister(IPR_BASE_OFFSET) & (1 << i);
-
-    // If there is a pending interrupt and a function exists
-    // for that interrupt input, execute the function
-    if (pendingIntr && isrFcnPtrs[i]) {
-      isrFcnPtrs[i]();
+// Rebuild the per-level masks of lines that can be dispatched.
+static void updateLevelMasks() {
+  for (uint8_t level = 0; level < INTERRUPTS_PRIORITY_LEVELS; level++)
+    levelMasks[level] = 0;
+  for (uint8_t i = 0; i < NUM_INTR_INPUTS; i++)
+    if (isrFcnPtrs[i] && (enabledLines & (1 << i)))
+      levelMasks[priorities[i]] |= 1 << i;
+}
+
+// Call the handler for a line, timing it if stats are enabled.
+static void runHandler(uint8_t irq) {
+  invocationCounts[irq]++;
+  if (!statsEnabled) {
+    isrFcnPtrs[irq]();
+    return;
+  }
+
+  timestamp_record(&latencyStats[irq], dispatchStart);
+  TIMESTAMP_MEASURE(&handlerStats[irq]) { isrFcnPtrs[irq](); }
+}
+
+// True if a line at a priority above the given level can be dispatched.
+static bool higherLevelsUsed(int8_t level) {
+  for (int8_t higher = level + 1; higher < INTERRUPTS_PRIORITY_LEVELS; higher++)
+    if (levelMasks[higher])
+      return true;
+  return false;
+}
+
+// Run the handlers of every pending line above the given priority, highest
+// priority first. The pending register is read once, and the levels are
+// walked from that snapshot, skipping levels with no lines. It is only read
+// again after a level's handlers have run, and only if there is a higher
+// level that could have been raised meanwhile. Lower priority lines raised
+// meanwhile keep the controller's output asserted, so they are picked up by
+// the next dispatch. The lines are level-sensitive, so each is acknowledged
+// only after its handler has cleared the source, and all of a level's lines
+// are acknowledged with a single write.
+static void dispatch(int8_t abovePriority) {
+  int8_t interruptedPriority = currentPriority;
+  uint32_t pendingLines = readRegister(IPR_BASE_OFFSET);
+
+  for (int8_t level = INTERRUPTS_PRIORITY_LEVELS - 1; level > abovePriority;
+       level--) {
+    if (!levelMasks[level])
+      continue;
+    uint32_t pending = pendingLines & levelMasks[level];
+    if (!pending)
+      continue;
+
+    currentPriority = level;
+    uint32_t handled = pending;
+    while (pending) {
+      runHandler(__builtin_ctz(pending));
+      pending &= pending - 1;
     }
+    writeRegister(IAR_BASE_OFFSET, handled);
 
-    // Acknowledge the interrupt to the controller
-    writeRegister(IAR_BASE_OFFSET, (1 << i));
+    // Something of higher priority may have come in while these ran
+    if (higherLevelsUsed(level)) {
+      pendingLines = readRegister(IPR_BASE_OFFSET);
+      level = INTERRUPTS_PRIORITY_LEVELS;
+    }
   }
-}
\ No newline at end of file
+
+  currentPriority = interruptedPriority;
+}
+
+// Checks for interrupts and calls appropriate interrupt
+// service routines given by the user, highest priority first.
+static void interrupts_isr() {
+  if (statsEnabled)
+    dispatchStart = timestamp_now();
+  dispatch(NO_PRIORITY);
+}
@@ -14,6 +14,10 @@ For questions, contact Brad Hutchings or Jeff Goeders, https://ece.byu.edu/
 
 #include <stdint.h>
 
+// Number of interrupt priority levels. Level 0 is the lowest and the default.
+#define INTERRUPTS_PRIORITY_LEVELS 4
+#define INTERRUPTS_DEFAULT_PRIORITY 0
+
 // Initialize interrupt hardware
 // This function should:
 // 1. Configure AXI INTC registers to:
@@ -37,4 +41,26 @@ void interrupts_irq_enable(uint8_t irq);
 // Disable single input interrupt line, given by irq number.
 void interrupts_irq_disable(uint8_t irq);
 
+// Set the priority of an input line (0 to INTERRUPTS_PRIORITY_LEVELS - 1).
+// When several lines are pending, higher priority lines are handled first, and
+// a line that becomes pending while lower priority handlers are still waiting
+// to run is handled before them.
+void interrupts_setPriority(uint8_t irq, uint8_t priority);
+
+// Call from inside a long interrupt handler to let higher priority lines
+// interrupt it: any that are pending are handled right away, nested inside
+// the current handler.
+void interrupts_runHigherPriority();
+
+// Start timing the handler of every line (see timestamp.h).
+void interrupts_enableStats();
+
+// Return the number of times the handler for a line has been called.
+uint32_t interrupts_getInvocationCount(uint8_t irq);
+
+// Print, for every line that has been handled, its priority, invocation count,
+// average and worst latency (from the interrupt to the handler being called)
+// and average and worst handler run time.
+void interrupts_printStats();
+
 #endif /* INTERRUPTS */
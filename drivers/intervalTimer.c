@@ -197,6 +197,11 @@ void intervalTimer_ackInterrupt(uint8_t timerNumber) {
   writeRegister(timerNumber, TCSR0_ADDR_OFFSET, configData);
 }
 
+// Return true if the timer has rolled over and hasn't been acknowledged.
+bool intervalTimer_isInterruptPending(uint8_t timerNumber) {
+  return readRegister(timerNumber, TCSR0_ADDR_OFFSET) & T0INT_MASK;
+}
+
 /***********HELPER FUNCTIONS************/
 
 // Reads from the specified timer's device base register address
@@ -84,4 +84,8 @@ void intervalTimer_disableInterrupt(uint8_t timerNumber);
 // Acknowledge the rollover to clear the interrupt output.
 void intervalTimer_ackInterrupt(uint8_t timerNumber);
 
+// Return true if the timer has rolled over since its interrupt was last
+// acknowledged, whether or not its interrupt output is enabled.
+bool intervalTimer_isInterruptPending(uint8_t timerNumber);
+
 #endif /* INTERVALTIMER */
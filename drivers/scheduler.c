@@ -0,0 +1,156 @@
+#include "scheduler.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+#include "idle.h"
+#include "intervalTimer.h"
+#include "timestamp.h"
+
+#define SECONDS_TO_MS 1000.0
+
+typedef struct {
+  const char *name;
+  void (*tick)();
+  uint32_t period;       // Base ticks between releases
+  uint32_t release;      // Base tick of the next release
+  scheduler_priority_t priority;
+  uint32_t overrunCount; // Releases missed because the task ran too late
+  uint32_t shedCount;    // Releases skipped to shed load
+  timestamp_stat_t runTime;
+} task_t;
+
+// Hardware timer driving the scheduler and its base tick period
+static uint32_t hardwareTimer;
+static double basePeriod;
+
+// Tasks, kept in the order they run: shortest period first, then highest
+// priority first
+static task_t tasks[SCHEDULER_MAX_TASKS];
+static uint8_t taskCount;
+
+// Base ticks are counted by the ISR and serviced by the main loop. Each counter
+// only has a single writer, so neither side needs to disable interrupts.
+static volatile uint32_t ticksRaised;
+static uint32_t ticksServiced;
+
+/***********HELPER FUNCTIONS************/
+
+// True if task a runs before task b.
+static bool runsBefore(task_t *a, task_t *b) {
+  if (a->period != b->period)
+    return a->period < b->period;
+  return a->priority > b->priority;
+}
+
+// Return the highest priority that is shed when a pass starts the given number
+// of base ticks late, or -1 if nothing is shed.
+static int8_t shedPriority(uint32_t lateTicks) {
+  if (lateTicks >= SCHEDULER_SHED_NORMAL_TICKS)
+    return SCHEDULER_PRIORITY_NORMAL;
+  if (lateTicks >= SCHEDULER_SHED_LOW_TICKS)
+    return SCHEDULER_PRIORITY_LOW;
+  return -1;
+}
+
+/***********HEADER FUNCTIONS************/
+
+// Initialize the scheduler and start its base timer.
+void scheduler_init(uint32_t timerNumber, double basePeriodSeconds) {
+  hardwareTimer = timerNumber;
+  basePeriod = basePeriodSeconds;
+  taskCount = 0;
+  ticksRaised = 0;
+  ticksServiced = 0;
+  timestamp_init();
+
+  intervalTimer_initCountDown(hardwareTimer, basePeriod);
+  intervalTimer_enableInterrupt(hardwareTimer);
+  intervalTimer_start(hardwareTimer);
+}
+
+// Count a base tick.
+void scheduler_isr() {
+  intervalTimer_ackInterrupt(hardwareTimer);
+  ticksRaised++;
+}
+
+// Add a task, keeping the tasks in rate-monotonic order.
+void scheduler_addTask(const char *name, void (*tick)(), double periodSeconds,
+                       scheduler_priority_t priority) {
+  if (taskCount == SCHEDULER_MAX_TASKS) {
+    printf("scheduler_addTask: no room for task %s\n", name);
+    assert(false);
+    return;
+  }
+
+  uint32_t period = periodSeconds / basePeriod + 0.5;
+  if (!period)
+    period = 1;
+
+  // The first release is a full period away, as if the task had just run
+  task_t task = {.name = name,
+                 .tick = tick,
+                 .period = period,
+                 .release = ticksRaised + period,
+                 .priority = priority};
+
+  // Insertion sort: move later tasks up to make room
+  uint8_t i = taskCount++;
+  while (i > 0 && runsBefore(&task, &tasks[i - 1])) {
+    tasks[i] = tasks[i - 1];
+    i--;
+  }
+  tasks[i] = task;
+}
+
+// Return true if a base tick hasn't been serviced.
+bool scheduler_ticksPending() { return ticksRaised != ticksServiced; }
+
+// Run every released task once, in order, shedding load if the pass is late.
+void scheduler_service() {
+  uint32_t now = ticksRaised;
+  int8_t shed = shedPriority(now - ticksServiced - 1);
+  ticksServiced = now;
+
+  for (uint8_t i = 0; i < taskCount; i++) {
+    task_t *task = &tasks[i];
+    if ((int32_t)(now - task->release) < 0)
+      continue;
+
+    // Releases that came and went before the task got to run are dropped
+    uint32_t missed = (now - task->release) / task->period;
+    task->overrunCount += missed;
+    task->release += (missed + 1) * task->period;
+
+    if ((int8_t)task->priority <= shed) {
+      task->shedCount++;
+      continue;
+    }
+    TIMESTAMP_MEASURE(&task->runTime) { task->tick(); }
+  }
+}
+
+// Sleep and service tasks for the given number of base ticks.
+void scheduler_run(uint32_t baseTicks) {
+  while (!baseTicks || ticksServiced < baseTicks) {
+    idle_waitUntil(scheduler_ticksPending);
+    scheduler_service();
+  }
+}
+
+// Return the number of base ticks raised since init.
+uint32_t scheduler_getTickCount() { return ticksRaised; }
+
+// Print every task's stats.
+void scheduler_printStats() {
+  printf("Scheduler: %lu base ticks of %.1f ms\n", (unsigned long)ticksRaised,
+         basePeriod * SECONDS_TO_MS);
+  for (uint8_t i = 0; i < taskCount; i++) {
+    task_t *task = &tasks[i];
+    printf("%s: every %lu ticks, priority %d, %lu overruns, %lu shed\n",
+           task->name, (unsigned long)task->period, task->priority,
+           (unsigned long)task->overrunCount, (unsigned long)task->shedCount);
+    timestamp_printStat(task->name, &task->runTime);
+  }
+}
@@ -0,0 +1,74 @@
+#ifndef SCHEDULER
+#define SCHEDULER
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Most tasks that can be added
+#define SCHEDULER_MAX_TASKS 8
+
+// Load shedding thresholds. When a pass over the tasks starts this many base
+// ticks late, tasks of the given priority and below are skipped until the
+// scheduler has caught up.
+#define SCHEDULER_SHED_LOW_TICKS 2
+#define SCHEDULER_SHED_NORMAL_TICKS 4
+
+// Task priority. Tasks run in rate-monotonic order (shortest period first), and
+// priority only breaks ties between tasks of the same period. Its main use is
+// deciding what can be dropped when the scheduler falls behind: low priority
+// tasks go first, then normal ones. High priority tasks are never shed.
+typedef enum {
+  SCHEDULER_PRIORITY_LOW,
+  SCHEDULER_PRIORITY_NORMAL,
+  SCHEDULER_PRIORITY_HIGH
+} scheduler_priority_t;
+
+// The scheduler runs tick functions at their own periods from a single
+// interval timer. The timer's ISR only counts base ticks; the tasks run to
+// completion, one after the other, in the main loop, and the CPU sleeps
+// between passes (see idle.h).
+//
+// Typical use:
+//   interrupts_register(INTERVAL_TIMER_0_INTERRUPT_IRQ, scheduler_isr);
+//   interrupts_irq_enable(INTERVAL_TIMER_0_INTERRUPT_IRQ);
+//   scheduler_init(INTERVAL_TIMER_0, 10.0E-3);
+//   scheduler_addTask("touch", touchscreen_tick, 10.0E-3,
+//                     SCHEDULER_PRIORITY_HIGH);
+//   scheduler_addTask("game", game_tick, 50.0E-3, SCHEDULER_PRIORITY_NORMAL);
+//   scheduler_run(0);
+//
+// A task whose release comes around again before it got to run has overrun:
+// the missed releases are counted and dropped, not run late one after the
+// other.
+
+// Initialize the scheduler with the given base tick period, using the given
+// interval timer, which will be set up to count down and started. The timer's
+// interrupt must be registered to call scheduler_isr(). Removes every task.
+void scheduler_init(uint32_t timerNumber, double basePeriodSeconds);
+
+// Interrupt handler for the scheduler's interval timer.
+void scheduler_isr();
+
+// Add a task that calls tick every periodSeconds (rounded to a whole number of
+// base ticks), first one period from now. The name is used in the stats.
+void scheduler_addTask(const char *name, void (*tick)(), double periodSeconds,
+                       scheduler_priority_t priority);
+
+// Return true if a base tick has been raised that hasn't been serviced.
+bool scheduler_ticksPending();
+
+// Run every task that has been released since the last call, then return.
+void scheduler_service();
+
+// Sleep and service tasks until the given number of base ticks have been
+// raised since init, or forever if it is 0.
+void scheduler_run(uint32_t baseTicks);
+
+// Return the number of base ticks raised since init.
+uint32_t scheduler_getTickCount();
+
+// Print every task's run, overrun and shed counts and its average and worst
+// run time.
+void scheduler_printStats();
+
+#endif /* SCHEDULER */
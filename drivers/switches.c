@@ -2,18 +2,42 @@
 #include "xil_io.h"
 #include "xparameters.h"
 
+#include "idle.h"
+#if XPAR_SLIDE_SWITCHES_INTERRUPT_PRESENT
+#include "interrupts.h"
+#endif
+
 #include <stdio.h>
 
 // Defining offsets from base address for the switch device drivers
 #define SWITCHES_DATA_ADDR_OFFSET 0x00
 #define SWITCHES_TRI_ADDR_OFFSET 0x04
+#define SWITCHES_GIER_ADDR_OFFSET 0x11C   // Global interrupt enable
+#define SWITCHES_IP_ISR_ADDR_OFFSET 0x120 // Interrupt status (write to clear)
+#define SWITCHES_IP_IER_ADDR_OFFSET 0x128 // Interrupt enable
+
+// Interrupt register bits
+#define SWITCHES_GIER_ENABLE_MASK 0x80000000
+#define SWITCHES_CHANNEL1_MASK 0x1
 
 // Configure each switch as an input by deactivating tri-state drivers
 #define SWITCHES_TRI_DISABLE 0x0F
 
+// True once switches_enableWakeups() has been called, so waiting can sleep
+static bool wakeupsEnabled = false;
+
+// switches_waitForChange() waits for the switches to read something other than
+// waitFrom, and keeps the value that differed in lastRead
+static uint8_t waitFrom;
+static uint8_t lastRead;
+
 // Declare some helper functions
 static uint32_t readRegister(uint32_t offset);
 static void writeRegister(uint32_t offset, uint32_t value);
+static bool switchesChanged();
+#if XPAR_SLIDE_SWITCHES_INTERRUPT_PRESENT
+static void switches_isr();
+#endif
 
 /***********HEADER FUNCTIONS************/
 
@@ -26,6 +50,32 @@ void switches_init() {
 // Returns the state of the 4 switches in one packaged integer
 uint8_t switches_read() { return readRegister(SWITCHES_DATA_ADDR_OFFSET); }
 
+// Let waiting sleep, using the GPIO interrupt if there is one
+bool switches_enableWakeups() {
+  wakeupsEnabled = true;
+#if XPAR_SLIDE_SWITCHES_INTERRUPT_PRESENT
+  interrupts_register(XPAR_AXI_INTC_0_SLIDE_SWITCHES_IP2INTC_IRPT_INTR,
+                      switches_isr);
+  interrupts_irq_enable(XPAR_AXI_INTC_0_SLIDE_SWITCHES_IP2INTC_IRPT_INTR);
+  writeRegister(SWITCHES_IP_IER_ADDR_OFFSET, SWITCHES_CHANNEL1_MASK);
+  writeRegister(SWITCHES_GIER_ADDR_OFFSET, SWITCHES_GIER_ENABLE_MASK);
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Wait until the switches read differently from last
+uint8_t switches_waitForChange(uint8_t last) {
+  waitFrom = last;
+  if (wakeupsEnabled)
+    idle_waitUntil(switchesChanged);
+  else
+    while (!switchesChanged())
+      ;
+  return lastRead;
+}
+
 /***********HELPER FUNCTIONS************/
 
 // Reads from the switches' device base register address
@@ -38,4 +88,20 @@ static uint32_t readRegister(uint32_t offset) {
 // register address + the given address offset
 static void writeRegister(uint32_t offset, uint32_t value) {
   Xil_Out32(XPAR_SLIDE_SWITCHES_BASEADDR + offset, value);
-}
\ No newline at end of file
+}
+
+// Read the switches and return true if they differ from waitFrom. Called with
+// interrupts masked from idle_waitUntil(), so a change can't slip in between
+// this read and the CPU going to sleep.
+static bool switchesChanged() {
+  lastRead = switches_read();
+  return lastRead != waitFrom;
+}
+
+#if XPAR_SLIDE_SWITCHES_INTERRUPT_PRESENT
+// Acknowledge a change of the switches. The interrupt is only there to wake the
+// CPU, the waiting code reads the new value itself.
+static void switches_isr() {
+  writeRegister(SWITCHES_IP_ISR_ADDR_OFFSET, SWITCHES_CHANNEL1_MASK);
+}
+#endif
@@ -12,6 +12,7 @@ For questions, contact Brad Hutchings or Jeff Goeders, https://ece.byu.edu/
 #ifndef SWITCHES
 #define SWITCHES
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #define SWITCHES_SW0_MASK 0x1
@@ -26,4 +27,15 @@ void switches_init();
 // returned value. bit3 = SW3, bit2 = SW2, bit1 = SW1, bit0 = SW0.
 uint8_t switches_read();
 
+// Let switches_waitForChange() sleep until an interrupt instead of reading the
+// switches over and over. If this hardware build connects the switch GPIO's
+// interrupt, it is registered with the interrupts driver (call this after
+// interrupts_init()) and true is returned. Otherwise false is returned, and
+// the caller must keep some other interrupt coming, such as a periodic timer,
+// so that changes are still seen.
+bool switches_enableWakeups();
+
+// Wait until the switches read differently from last, and return the new value.
+uint8_t switches_waitForChange(uint8_t last);
+
 #endif /* SWITCHES */
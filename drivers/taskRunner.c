@@ -0,0 +1,136 @@
+#include "taskRunner.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+
+#ifndef ZYBO_BOARD
+#include <pthread.h>
+#include <sched.h>
+
+// Workers besides the calling core
+#define WORKERS (TASKRUNNER_CORES - 1)
+#endif
+
+typedef struct {
+  taskRunner_function_t function;
+  void *arg;
+} task_t;
+
+// Tasks are numbered in the order they are submitted, and task n is kept in
+// tasks[n % TASKRUNNER_MAX_TASKS]. The counters only ever increase (wrapping
+// around), so a worker that is late to leave one batch can never claim a task
+// number twice.
+static task_t tasks[TASKRUNNER_MAX_TASKS];
+static uint32_t pendingTasks; // Submitted, not yet started (calling core only)
+static atomic_uint nextTask;  // Next task to claim
+static atomic_uint endTask;   // Tasks before this one have been started
+static atomic_uint finishedTasks; // Number of tasks finished
+
+#ifndef ZYBO_BOARD
+// Workers sleep until the batch number changes
+static pthread_mutex_t batchLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t batchStarted = PTHREAD_COND_INITIALIZER;
+static uint32_t batchNumber;
+#endif
+
+/***********HELPER FUNCTIONS************/
+
+// Claim and run tasks until none are left
+static void runTasks() {
+  unsigned int task = atomic_load(&nextTask);
+
+  while (true) {
+    // The claim only succeeds if no other core took the task first
+    if ((int32_t)(task - atomic_load(&endTask)) >= 0)
+      return;
+    if (!atomic_compare_exchange_weak(&nextTask, &task, task + 1))
+      continue;
+
+    task_t *claimed = &tasks[task % TASKRUNNER_MAX_TASKS];
+    claimed->function(claimed->arg);
+    atomic_fetch_add(&finishedTasks, 1);
+    task = atomic_load(&nextTask);
+  }
+}
+
+#ifndef ZYBO_BOARD
+// Body of a worker thread: wait for a batch, help run it, repeat
+static void *worker(void *unused) {
+  (void)unused;
+  uint32_t lastBatch = 0;
+
+  while (true) {
+    pthread_mutex_lock(&batchLock);
+    while (batchNumber == lastBatch)
+      pthread_cond_wait(&batchStarted, &batchLock);
+    lastBatch = batchNumber;
+    pthread_mutex_unlock(&batchLock);
+
+    runTasks();
+  }
+  return NULL;
+}
+#endif
+
+/***********HEADER FUNCTIONS************/
+
+// Start the worker(s).
+void taskRunner_init() {
+#ifndef ZYBO_BOARD
+  for (uint8_t i = 0; i < WORKERS; i++) {
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, worker, NULL) != 0) {
+      printf("taskRunner_init: could not start worker %d\n", i);
+      continue;
+    }
+    pthread_detach(thread);
+  }
+#endif
+}
+
+// Add a task to the batch.
+bool taskRunner_submit(taskRunner_function_t function, void *arg) {
+  if (pendingTasks == TASKRUNNER_MAX_TASKS)
+    return false;
+
+  task_t *task =
+      &tasks[(atomic_load(&endTask) + pendingTasks) % TASKRUNNER_MAX_TASKS];
+  task->function = function;
+  task->arg = arg;
+  pendingTasks++;
+  return true;
+}
+
+// Run every task in the batch on all cores.
+void taskRunner_runAll() {
+  unsigned int end = atomic_load(&endTask) + pendingTasks;
+  pendingTasks = 0;
+
+  // Publishing the end of the batch makes its tasks claimable
+  atomic_store(&endTask, end);
+
+#ifndef ZYBO_BOARD
+  pthread_mutex_lock(&batchLock);
+  batchNumber++;
+  pthread_cond_broadcast(&batchStarted);
+  pthread_mutex_unlock(&batchLock);
+#endif
+
+  // This core works on the batch too, then waits for the tasks the workers
+  // are still running
+  runTasks();
+  while (atomic_load(&finishedTasks) != end) {
+#ifndef ZYBO_BOARD
+    sched_yield();
+#endif
+  }
+}
+
+// Return the number of cores that actually run tasks.
+uint8_t taskRunner_getCoreCount() {
+#ifdef ZYBO_BOARD
+  return 1;
+#else
+  return TASKRUNNER_CORES;
+#endif
+}
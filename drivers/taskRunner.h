@@ -0,0 +1,47 @@
+#ifndef TASKRUNNER
+#define TASKRUNNER
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Number of cores tasks are spread over. The Zynq has two Cortex-A9 cores.
+#define TASKRUNNER_CORES 2
+
+// Most tasks in one batch.
+#define TASKRUNNER_MAX_TASKS 64
+
+// A task is a function and the argument it is called with.
+typedef void (*taskRunner_function_t)(void *arg);
+
+// The task runner splits a batch of independent tasks between the cores: the
+// calling core queues tasks with taskRunner_submit(), then taskRunner_runAll()
+// has every core take tasks from the batch, one at a time, until it is empty.
+// Tasks may run in any order and at the same time, so anything they share must
+// be safe to use from both cores.
+//
+// On the emulator and headless builds the second core is a thread. The board
+// build has no program for CPU1 (the BSP only brings up ps7_cortexa9_0), so
+// there every task runs on the calling core; code using the runner behaves the
+// same, it just doesn't run faster.
+//
+// Typical use:
+//   for (uint8_t i = 0; i < count; i++)
+//     taskRunner_submit(searchSubtree, &jobs[i]);
+//   taskRunner_runAll();
+
+// Start the worker(s). Call once before any other taskRunner function.
+void taskRunner_init();
+
+// Add a task to the batch. Returns false (and doesn't add it) if the batch
+// already has TASKRUNNER_MAX_TASKS tasks.
+bool taskRunner_submit(taskRunner_function_t function, void *arg);
+
+// Run every task in the batch on all cores, and return once all of them have
+// finished. The batch is then empty.
+void taskRunner_runAll();
+
+// Return the number of cores that actually run tasks: TASKRUNNER_CORES, or 1
+// on the board.
+uint8_t taskRunner_getCoreCount();
+
+#endif /* TASKRUNNER */
@@ -0,0 +1,78 @@
+#include "textField.h"
+
+#include <stdio.h>
+
+// Screen width/height of a single character cell, in pixels.
+#define CHAR_PIXEL_WIDTH(field) (DISPLAY_CHAR_WIDTH * (field)->size)
+#define CHAR_PIXEL_HEIGHT(field) (DISPLAY_CHAR_HEIGHT * (field)->size)
+
+/***********HELPER FUNCTIONS************/
+
+// Draw a single character cell of the field. The background is drawn along
+// with the glyph, which overwrites whatever character was there before.
+static void drawCell(textField_t *field, uint8_t index, char c) {
+  display_drawChar(field->x + index * CHAR_PIXEL_WIDTH(field), field->y, c,
+                   field->color, field->bg, field->size);
+}
+
+// Clear the character cells [from, to) back to the background color.
+static void clearCells(textField_t *field, uint8_t from, uint8_t to) {
+  if (from >= to)
+    return;
+
+  display_fillRect(field->x + from * CHAR_PIXEL_WIDTH(field), field->y,
+                   (to - from) * CHAR_PIXEL_WIDTH(field),
+                   CHAR_PIXEL_HEIGHT(field), field->bg);
+}
+
+/***********HEADER FUNCTIONS************/
+
+// Initialize a text field at (x, y). Nothing is drawn until the first call to
+// textField_draw().
+void textField_init(textField_t *field, int16_t x, int16_t y, uint8_t size,
+                    uint16_t color, uint16_t bg) {
+  field->x = x;
+  field->y = y;
+  field->size = size;
+  field->color = color;
+  field->bg = bg;
+  field->length = 0;
+  field->drawn = false;
+  field->text[0] = '\0';
+
+  // Opaque glyphs need a background that differs from the foreground, or the
+  // display library falls back to transparent drawing.
+  if (color == bg)
+    printf("textField_init: color and bg are the same, characters will not "
+           "erase what is underneath them\n");
+}
+
+// Draw str into the field, only touching characters that changed.
+void textField_draw(textField_t *field, const char *str) {
+  uint8_t i;
+
+  // Redraw each character that differs from what is on screen
+  for (i = 0; str[i] != '\0' && i < TEXTFIELD_MAX_CHARS; i++) {
+    if (!field->drawn || i >= field->length || field->text[i] != str[i]) {
+      drawCell(field, i, str[i]);
+      field->text[i] = str[i];
+    }
+  }
+
+  // Clear any leftover characters from a longer previous string
+  clearCells(field, i, field->length);
+
+  field->text[i] = '\0';
+  field->length = i;
+  field->drawn = true;
+}
+
+// Forget what is on the screen, so the next draw repaints every character.
+void textField_invalidate(textField_t *field) { field->drawn = false; }
+
+// Clear the field to its background color and forget its contents.
+void textField_erase(textField_t *field) {
+  clearCells(field, 0, field->length);
+  field->length = 0;
+  field->text[0] = '\0';
+}
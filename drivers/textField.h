@@ -0,0 +1,44 @@
+#ifndef TEXTFIELD
+#define TEXTFIELD
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "display.h"
+
+// Longest string a single text field can hold (not including the null).
+#define TEXTFIELD_MAX_CHARS 40
+
+// A text field is a fixed position on the screen that remembers the last string
+// drawn there. Each call to textField_draw() only redraws the characters that
+// differ from what is already on the screen. Characters are drawn with an
+// opaque background, so no separate erase pass is ever needed.
+typedef struct {
+  int16_t x;      // Upper-left corner of the first character
+  int16_t y;      // Upper-left corner of the first character
+  uint8_t size;   // Text size multiplier (1 = 6x8 pixel characters)
+  uint16_t color; // Foreground color of the text
+  uint16_t bg;    // Background color drawn behind each character
+  uint8_t length; // Number of characters currently on the screen
+  bool drawn;     // True once the field has been drawn at least once
+  char text[TEXTFIELD_MAX_CHARS + 1]; // The characters currently on the screen
+} textField_t;
+
+// Initialize a text field at (x, y). Nothing is drawn until the first call to
+// textField_draw(). bg should match whatever is behind the field on screen.
+void textField_init(textField_t *field, int16_t x, int16_t y, uint8_t size,
+                    uint16_t color, uint16_t bg);
+
+// Draw str into the field, only touching characters that changed since the
+// last draw. If str is shorter than the previous string, the leftover
+// characters are cleared to the background color.
+void textField_draw(textField_t *field, const char *str);
+
+// Forget what is on the screen, so the next textField_draw() repaints every
+// character (for example after the screen has been cleared underneath it).
+void textField_invalidate(textField_t *field);
+
+// Clear the field to its background color and forget its contents.
+void textField_erase(textField_t *field);
+
+#endif /* TEXTFIELD */
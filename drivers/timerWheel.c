@@ -0,0 +1,297 @@
+#include "timerWheel.h"
+
+#include <stddef.h>
+
+#include "intervalTimer.h"
+
+#define SLOTS (1 << TIMERWHEEL_LEVEL_BITS)
+#define SLOT_MASK (SLOTS - 1)
+
+// Width of one slot at the given level, in ticks
+#define LEVEL_SHIFT(level) ((level) * TIMERWHEEL_LEVEL_BITS)
+
+// Timers further out than this are parked in the last level, in the furthest
+// slot that is not the current one, and moved down when that slot is reached
+#define MAX_DELTA_TICKS                                                        \
+  ((1UL << LEVEL_SHIFT(TIMERWHEEL_LEVELS)) -                                   \
+   (1UL << LEVEL_SHIFT(TIMERWHEEL_LEVELS - 1)))
+
+// Hardware timer driving the wheel and its tick period
+static uint32_t hardwareTimer;
+static double tickPeriod;
+
+// The wheel: one list of timers per slot, and a bitmap per level of the slots
+// that are not empty, so the next deadline is found with a count of trailing
+// zeros instead of a scan
+static timerWheel_timer_t *slots[TIMERWHEEL_LEVELS][SLOTS];
+static uint64_t occupied[TIMERWHEEL_LEVELS];
+
+// Tick the wheel has been advanced to. Between interrupts the real time is
+// somewhere between now and wakeTick.
+static uint32_t now;
+static uint32_t wakeTick;
+
+// Number of ticks the hardware timer is currently loaded with. It reloads
+// automatically, so it only has to be reprogrammed when this changes.
+static uint32_t loadedTicks;
+
+// True while the ISR is running, when the timer's interrupt doesn't need to be
+// masked to change the wheel
+static bool inIsr;
+
+static uint32_t interruptCount;
+
+/***********HELPER FUNCTIONS************/
+
+// Convert seconds to a number of ticks, rounded to the nearest tick and at
+// least one.
+static uint32_t toTicks(double seconds) {
+  uint32_t ticks = seconds / tickPeriod + 0.5;
+  return ticks ? ticks : 1;
+}
+
+// Keep the wheel's ISR from running while it is being changed.
+static void lock() {
+  if (!inIsr)
+    intervalTimer_disableInterrupt(hardwareTimer);
+}
+
+static void unlock() {
+  if (!inIsr)
+    intervalTimer_enableInterrupt(hardwareTimer);
+}
+
+// Rotate a slot bitmap right, so that bit 0 is the given slot.
+static uint64_t rotateToSlot(uint64_t bitmap, uint32_t slot) {
+  slot &= SLOT_MASK;
+  return slot ? (bitmap >> slot) | (bitmap << (SLOTS - slot)) : bitmap;
+}
+
+// Put a timer in the slot for its deadline, relative to the wheel's tick.
+static void addToWheel(timerWheel_timer_t *t) {
+  uint32_t delta = t->expires - now;
+  uint32_t when = t->expires;
+  if (delta > MAX_DELTA_TICKS) {
+    delta = MAX_DELTA_TICKS;
+    when = now + MAX_DELTA_TICKS;
+  }
+
+  uint8_t level = 0;
+  while (level < TIMERWHEEL_LEVELS - 1 &&
+         delta >= (1UL << LEVEL_SHIFT(level + 1)))
+    level++;
+  uint8_t slot = (when >> LEVEL_SHIFT(level)) & SLOT_MASK;
+
+  t->level = level;
+  t->slot = slot;
+  t->prev = NULL;
+  t->next = slots[level][slot];
+  if (t->next)
+    t->next->prev = t;
+  slots[level][slot] = t;
+  occupied[level] |= 1ULL << slot;
+  t->pending = true;
+}
+
+// Take a timer out of its slot.
+static void removeFromWheel(timerWheel_timer_t *t) {
+  if (t->prev)
+    t->prev->next = t->next;
+  else
+    slots[t->level][t->slot] = t->next;
+  if (t->next)
+    t->next->prev = t->prev;
+  if (!slots[t->level][t->slot])
+    occupied[t->level] &= ~(1ULL << t->slot);
+  t->pending = false;
+}
+
+// Number of ticks from now until something has to happen: a level 0 timer is
+// due, or a higher level slot is reached and its timers have to move down.
+static uint32_t ticksToNextEvent() {
+  uint32_t ticks = TIMERWHEEL_MAX_SLEEP_TICKS;
+
+  // Level 0 slots hold exactly the timers due on that tick
+  if (occupied[0]) {
+    uint32_t distance = __builtin_ctzll(rotateToSlot(occupied[0], now));
+    if (distance < ticks)
+      ticks = distance;
+  }
+
+  // A higher level slot is handled when the wheel reaches its start. The
+  // current slot was handled when it was reached, so the search starts at the
+  // next one.
+  for (uint8_t level = 1; level < TIMERWHEEL_LEVELS; level++) {
+    if (!occupied[level])
+      continue;
+    uint32_t block = now >> LEVEL_SHIFT(level);
+    uint32_t distance =
+        __builtin_ctzll(rotateToSlot(occupied[level], block + 1)) + 1;
+    uint32_t start = (block + distance) << LEVEL_SHIFT(level);
+    if (start - now < ticks)
+      ticks = start - now;
+  }
+  return ticks ? ticks : 1;
+}
+
+// Handle the wheel's current tick: move timers down from the higher level
+// slots that start on this tick, then run the timers due on it. Timers are
+// taken off the slot one at a time, so a callback can cancel any timer. A
+// timer is never put back into the slot it was taken from.
+static void processTick() {
+  for (int8_t level = TIMERWHEEL_LEVELS - 1; level > 0; level--) {
+    if (now & ((1UL << LEVEL_SHIFT(level)) - 1))
+      continue;
+    uint8_t slot = (now >> LEVEL_SHIFT(level)) & SLOT_MASK;
+    while (slots[level][slot]) {
+      timerWheel_timer_t *t = slots[level][slot];
+      removeFromWheel(t);
+      addToWheel(t);
+    }
+  }
+
+  // A periodic timer is put back before its callback runs, so the callback
+  // can cancel it
+  uint8_t slot = now & SLOT_MASK;
+  while (slots[0][slot]) {
+    timerWheel_timer_t *t = slots[0][slot];
+    removeFromWheel(t);
+    if (t->period) {
+      t->expires += t->period;
+      addToWheel(t);
+    }
+    t->callback();
+  }
+}
+
+// Load the hardware timer to interrupt after the given number of ticks.
+static void programTimer(uint32_t ticks) {
+  intervalTimer_initCountDown(hardwareTimer, ticks * tickPeriod);
+  intervalTimer_enableInterrupt(hardwareTimer);
+  intervalTimer_start(hardwareTimer);
+  loadedTicks = ticks;
+}
+
+// Return the number of ticks left before the hardware timer runs out.
+static uint32_t remainingHardwareTicks() {
+  double remaining = intervalTimer_getTotalDurationInSeconds(hardwareTimer);
+  return remaining / tickPeriod + 0.5;
+}
+
+// Start a timer due delayTicks from the current (real) time.
+static void startTimer(timerWheel_timer_t *t, uint32_t delayTicks,
+                       uint32_t periodTicks, void (*callback)()) {
+  lock();
+  if (t->pending)
+    removeFromWheel(t);
+
+  // Outside the ISR, the hardware timer has been counting since the wheel was
+  // last advanced. If it has already run out but its ISR hasn't run yet, it
+  // has reloaded and counts the next interval, so the whole interval to
+  // wakeTick has gone by as well as what it has counted since.
+  uint32_t elapsed = 0;
+  if (!inIsr) {
+    bool expired = intervalTimer_isInterruptPending(hardwareTimer);
+    uint32_t remainingTicks = remainingHardwareTicks();
+    if (!expired && intervalTimer_isInterruptPending(hardwareTimer)) {
+      // It ran out while being read, so read the reloaded counter again
+      expired = true;
+      remainingTicks = remainingHardwareTicks();
+    }
+
+    if (expired)
+      elapsed = wakeTick - now +
+                (remainingTicks < loadedTicks ? loadedTicks - remainingTicks
+                                              : 0);
+    else if (remainingTicks < wakeTick - now)
+      elapsed = wakeTick - now - remainingTicks;
+  }
+
+  t->expires = now + elapsed + delayTicks;
+  t->period = periodTicks;
+  t->callback = callback;
+  addToWheel(t);
+
+  // Wake up earlier if this timer is due before the next interrupt. The ISR
+  // reprograms the timer itself once it is done. (If the interrupt is already
+  // pending, wakeTick has passed and this timer is due after it.)
+  if (!inIsr && t->expires - now < wakeTick - now) {
+    wakeTick = t->expires;
+    programTimer(delayTicks);
+  }
+  unlock();
+}
+
+/***********HEADER FUNCTIONS************/
+
+// Initialize the wheel with the given tick resolution and interval timer.
+void timerWheel_init(uint32_t timerNumber, double tickPeriodSeconds) {
+  hardwareTimer = timerNumber;
+  tickPeriod = tickPeriodSeconds;
+
+  for (uint8_t level = 0; level < TIMERWHEEL_LEVELS; level++) {
+    for (uint8_t slot = 0; slot < SLOTS; slot++)
+      slots[level][slot] = NULL;
+    occupied[level] = 0;
+  }
+  now = 0;
+  wakeTick = TIMERWHEEL_MAX_SLEEP_TICKS;
+  inIsr = false;
+  interruptCount = 0;
+
+  programTimer(TIMERWHEEL_MAX_SLEEP_TICKS);
+}
+
+// Run every timer that is due, then program the next interrupt.
+void timerWheel_isr() {
+  intervalTimer_ackInterrupt(hardwareTimer);
+  interruptCount++;
+  inIsr = true;
+
+  // Nothing happens between events, so the wheel can jump from one to the next
+  while (now != wakeTick) {
+    uint32_t ticks = ticksToNextEvent();
+    if (ticks > wakeTick - now)
+      ticks = wakeTick - now;
+    now += ticks;
+    processTick();
+  }
+
+  uint32_t ticks = ticksToNextEvent();
+  wakeTick = now + ticks;
+  if (ticks != loadedTicks)
+    programTimer(ticks);
+  inIsr = false;
+}
+
+// Start a timer that calls callback every periodSeconds.
+void timerWheel_startPeriodic(timerWheel_timer_t *timer, double periodSeconds,
+                              void (*callback)()) {
+  uint32_t period = toTicks(periodSeconds);
+  startTimer(timer, period, period, callback);
+}
+
+// Start a timer that calls callback once, delaySeconds from now.
+void timerWheel_startOneShot(timerWheel_timer_t *timer, double delaySeconds,
+                             void (*callback)()) {
+  startTimer(timer, toTicks(delaySeconds), 0, callback);
+}
+
+// Stop a timer if it is pending.
+void timerWheel_cancel(timerWheel_timer_t *timer) {
+  lock();
+  if (timer->pending)
+    removeFromWheel(timer);
+  unlock();
+}
+
+// Return true if the timer is waiting to be called.
+bool timerWheel_isPending(timerWheel_timer_t *timer) {
+  return timer->pending;
+}
+
+// Return the number of ticks since init.
+uint32_t timerWheel_getTickCount() { return now; }
+
+// Return the number of times the hardware timer has interrupted since init.
+uint32_t timerWheel_getInterruptCount() { return interruptCount; }
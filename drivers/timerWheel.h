@@ -0,0 +1,76 @@
+#ifndef TIMERWHEEL
+#define TIMERWHEEL
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Each level of the wheel has 2^TIMERWHEEL_LEVEL_BITS slots. Level 0 slots are
+// one tick wide, level 1 slots are 64 ticks wide and level 2 slots are 4096
+// ticks wide; a timer further out than the wheel reaches is parked in the last
+// level and moved down as its deadline gets closer.
+#define TIMERWHEEL_LEVEL_BITS 6
+#define TIMERWHEEL_LEVELS 3
+
+// Longest the hardware timer is left to run, in ticks, when nothing is due
+// sooner. The wheel's tick count keeps following real time even when it is
+// empty.
+#define TIMERWHEEL_MAX_SLEEP_TICKS 4096
+
+// A software timer. The caller owns the storage (usually a static variable)
+// and must not touch the fields; they are only in the header so a timer can be
+// declared without allocating. A zeroed timer is a stopped timer.
+typedef struct timerWheel_timer_t {
+  struct timerWheel_timer_t *next; // Neighbors in the slot's list
+  struct timerWheel_timer_t *prev;
+  uint32_t expires;                // Tick the timer is due on
+  uint32_t period;                 // Ticks between calls, 0 for a one-shot
+  void (*callback)();              // Called from the ISR when due
+  bool pending;                    // Waiting in the wheel
+  uint8_t level;                   // Wheel level and slot it is waiting in
+  uint8_t slot;
+} timerWheel_timer_t;
+
+// The timer wheel lets any number of periodic and one-shot callbacks share a
+// single hardware interval timer. Starting and cancelling a timer is O(1), and
+// the hardware timer is programmed to interrupt only when the next timer is
+// due (or the wheel has to move timers down a level), rather than every tick.
+//
+// Typical use:
+//   interrupts_register(INTERVAL_TIMER_0_INTERRUPT_IRQ, timerWheel_isr);
+//   interrupts_irq_enable(INTERVAL_TIMER_0_INTERRUPT_IRQ);
+//   timerWheel_init(INTERVAL_TIMER_0, 5.0E-3);
+//   timerWheel_startPeriodic(&gameTimer, 45.0E-3, game_tick);
+//
+// Callbacks run inside the timer's ISR, so they should be short.
+
+// Initialize the wheel with the given tick resolution, using the given
+// interval timer, which will be set up to count down and started. The timer's
+// interrupt must be registered to call timerWheel_isr().
+void timerWheel_init(uint32_t timerNumber, double tickPeriodSeconds);
+
+// Interrupt handler for the wheel's interval timer. Runs every timer that is
+// due, then programs the hardware timer for the next deadline.
+void timerWheel_isr();
+
+// Start (or restart) a timer that calls callback every periodSeconds, first
+// one period from now. The period is rounded to a whole number of ticks.
+void timerWheel_startPeriodic(timerWheel_timer_t *timer, double periodSeconds,
+                              void (*callback)());
+
+// Start (or restart) a timer that calls callback once, delaySeconds from now.
+void timerWheel_startOneShot(timerWheel_timer_t *timer, double delaySeconds,
+                             void (*callback)());
+
+// Stop a timer. Does nothing if the timer isn't pending.
+void timerWheel_cancel(timerWheel_timer_t *timer);
+
+// Return true if the timer is waiting to be called.
+bool timerWheel_isPending(timerWheel_timer_t *timer);
+
+// Return the number of ticks since init.
+uint32_t timerWheel_getTickCount();
+
+// Return the number of times the hardware timer has interrupted since init.
+uint32_t timerWheel_getInterruptCount();
+
+#endif /* TIMERWHEEL */
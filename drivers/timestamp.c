@@ -0,0 +1,47 @@
+#include "timestamp.h"
+
+#include <stdio.h>
+
+// Global timer control register: timer enable bit
+#define CONTROL_TIMER_ENABLE_MASK 0x1
+
+#define NANOSECONDS_PER_SECOND 1000000000ULL
+#define MICROSECONDS_PER_SECOND 1000000ULL
+
+uint32_t timestamp_nanosecondsFactor;
+uint32_t timestamp_microsecondsFactor;
+
+/***********HEADER FUNCTIONS************/
+
+// Start the counter if needed and compute the conversion factors.
+void timestamp_init() {
+#ifdef ZYBO_BOARD
+  // The global timer is shared by both cores and never stopped, so it is only
+  // ever enabled, not reset
+  uint32_t control = Xil_In32(TIMESTAMP_CONTROL);
+  if (!(control & CONTROL_TIMER_ENABLE_MASK))
+    Xil_Out32(TIMESTAMP_CONTROL, control | CONTROL_TIMER_ENABLE_MASK);
+#endif
+
+  // Rounded to the nearest fixed point value
+  timestamp_nanosecondsFactor =
+      ((NANOSECONDS_PER_SECOND << TIMESTAMP_NANOSECONDS_SHIFT) +
+       TIMESTAMP_TICKS_PER_SECOND / 2) /
+      TIMESTAMP_TICKS_PER_SECOND;
+  timestamp_microsecondsFactor =
+      ((MICROSECONDS_PER_SECOND << TIMESTAMP_MICROSECONDS_SHIFT) +
+       TIMESTAMP_TICKS_PER_SECOND / 2) /
+      TIMESTAMP_TICKS_PER_SECOND;
+}
+
+// Print a stat's count and its average and worst time in microseconds.
+void timestamp_printStat(const char *name, timestamp_stat_t *stat) {
+  if (!stat->count) {
+    printf("%s: never run\n", name);
+    return;
+  }
+  printf("%s: %lu runs, average %.1f us, max %.1f us\n", name,
+         (unsigned long)stat->count,
+         timestamp_toSeconds(stat->total) / stat->count * MICROSECONDS_PER_SECOND,
+         timestamp_toSeconds(stat->max) * MICROSECONDS_PER_SECOND);
+}
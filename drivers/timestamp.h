@@ -0,0 +1,123 @@
+#ifndef TIMESTAMP
+#define TIMESTAMP
+
+#include <stdint.h>
+
+// Monotonic timestamps for timing code, cheap enough to take in hot paths and
+// ISRs. On the board they come from the ARM global timer, a 64-bit counter
+// running at half the CPU clock; the headless build counts the cycles of its
+// virtual time (see headless.h), so stats there measure virtual time; the
+// emulator uses clock_gettime() in nanoseconds. Take timestamps with
+// timestamp_now(), subtract them, and only convert the difference to time
+// units when it is reported.
+//
+//   timestamp_t start = timestamp_now();
+//   ...
+//   uint32_t us = timestamp_toMicroseconds(timestamp_now() - start);
+//
+// Or, to keep count, total and worst time of a piece of code:
+//
+//   static timestamp_stat_t drawStat;
+//   TIMESTAMP_MEASURE(&drawStat) { draw(); }
+
+#ifdef ZYBO_BOARD
+#include "xil_io.h"
+#include "xparameters.h"
+
+#define TIMESTAMP_COUNTER_LOWER                                                \
+  (XPAR_PS7_GLOBALTIMER_0_S_AXI_BASEADDR + 0x00)
+#define TIMESTAMP_COUNTER_UPPER                                                \
+  (XPAR_PS7_GLOBALTIMER_0_S_AXI_BASEADDR + 0x04)
+#define TIMESTAMP_CONTROL (XPAR_PS7_GLOBALTIMER_0_S_AXI_BASEADDR + 0x08)
+#define TIMESTAMP_TICKS_PER_SECOND (XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 2)
+#elif defined(HEADLESS)
+#include "headless.h"
+
+#define TIMESTAMP_TICKS_PER_SECOND HEADLESS_CLOCK_FREQ_HZ
+#else
+#include <time.h>
+
+#define TIMESTAMP_TICKS_PER_SECOND 1000000000
+#endif
+
+// Conversion factors are fixed point, with this many fractional bits. Both
+// factors fit in 24 bits, so differences up to 2^40 ticks (over 18 minutes on
+// any of the clocks) convert without overflow.
+#define TIMESTAMP_NANOSECONDS_SHIFT 20
+#define TIMESTAMP_MICROSECONDS_SHIFT 30
+
+// A timestamp, or a difference between two, in ticks
+typedef uint64_t timestamp_t;
+
+// Count, total and worst time of a measured piece of code, in ticks
+typedef struct {
+  uint32_t count;
+  timestamp_t total;
+  timestamp_t max;
+} timestamp_stat_t;
+
+// Nanoseconds and microseconds per tick, set by timestamp_init()
+extern uint32_t timestamp_nanosecondsFactor;
+extern uint32_t timestamp_microsecondsFactor;
+
+// Start the timestamp counter if needed and compute the conversion factors.
+// Call once before using the other functions; calling it again does no harm.
+void timestamp_init();
+
+// Return the current time in ticks.
+static inline timestamp_t timestamp_now() {
+#ifdef ZYBO_BOARD
+  // The upper half is read on both sides of the lower half, in case the lower
+  // half rolls over in between
+  uint32_t upper = Xil_In32(TIMESTAMP_COUNTER_UPPER);
+  uint32_t lower = Xil_In32(TIMESTAMP_COUNTER_LOWER);
+  uint32_t upperAgain = Xil_In32(TIMESTAMP_COUNTER_UPPER);
+  if (upper != upperAgain)
+    lower = Xil_In32(TIMESTAMP_COUNTER_LOWER);
+  return ((timestamp_t)upperAgain << 32) | lower;
+#elif defined(HEADLESS)
+  return headless_getCycles();
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (timestamp_t)ts.tv_sec * TIMESTAMP_TICKS_PER_SECOND + ts.tv_nsec;
+#endif
+}
+
+// Convert a number of ticks to nanoseconds.
+static inline uint64_t timestamp_toNanoseconds(timestamp_t ticks) {
+  return (ticks * timestamp_nanosecondsFactor) >> TIMESTAMP_NANOSECONDS_SHIFT;
+}
+
+// Convert a number of ticks to microseconds.
+static inline uint64_t timestamp_toMicroseconds(timestamp_t ticks) {
+  return (ticks * timestamp_microsecondsFactor) >>
+         TIMESTAMP_MICROSECONDS_SHIFT;
+}
+
+// Convert a number of ticks to seconds, for printing.
+static inline double timestamp_toSeconds(timestamp_t ticks) {
+  return (double)ticks / TIMESTAMP_TICKS_PER_SECOND;
+}
+
+// Add the time since start to a stat.
+static inline void timestamp_record(timestamp_stat_t *stat,
+                                    timestamp_t start) {
+  timestamp_t elapsed = timestamp_now() - start;
+  stat->count++;
+  stat->total += elapsed;
+  if (elapsed > stat->max)
+    stat->max = elapsed;
+}
+
+// Time the statement or block that follows and add it to a stat. Don't leave
+// the block with break, return or goto, or the time isn't recorded.
+#define TIMESTAMP_MEASURE(stat)                                                \
+  for (timestamp_t timestampStart_ = timestamp_now(), timestampDone_ = 0;      \
+       !timestampDone_; timestampDone_ = 1, timestamp_record((stat),           \
+                                                              timestampStart_))
+
+// Print a stat's count and its average and worst time in microseconds.
+void timestamp_printStat(const char *name, timestamp_stat_t *stat);
+
+#endif /* TIMESTAMP */
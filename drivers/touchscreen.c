@@ -1,12 +1,16 @@
 #include <math.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "interrupts.h"
 #include "intervalTimer.h"
 #include "touchscreen.h"
 
+#define QUEUE_INDEX_MASK (TOUCHSCREEN_EVENT_QUEUE_SIZE - 1)
+
 #define ADC_SETTLE_PERIOD_SECONDS 0.05
 
 // States defining the behavior of the higher-level touchscreen driver
@@ -31,8 +35,17 @@ static uint16_t touch_x, touch_y;
 // Amount of pressure used form the most recent touched point
 static uint8_t touch_z;
 
-// Declare helper function
+// Event queue. The tick is the only writer of tail and the reader the only
+// writer of head, so neither side needs to disable interrupts.
+static touchscreen_event_t events[TOUCHSCREEN_EVENT_QUEUE_SIZE];
+static volatile uint32_t eventHead;
+static volatile uint32_t eventTail;
+static uint32_t droppedEvents;
+
+// Declare helper functions
 static void debugStatePrint();
+static void readFilteredPoint();
+static void postEvent(touchscreen_event_type_t type);
 
 // Initialize the touchscreen driver state machine, with a given tick period (in
 // seconds).
@@ -45,6 +58,11 @@ void touchscreen_init(double period_seconds) {
   pressed = false;
   adc_timer = 0;
   adc_settle_ticks = ceil(ADC_SETTLE_PERIOD_SECONDS / period_seconds);
+
+  eventHead = 0;
+  eventTail = 0;
+  droppedEvents = 0;
+  timestamp_init();
 }
 
 // State machine error messages are defined here:
@@ -77,8 +95,8 @@ void touchscreen_tick() {
     // coordinates of the touched location
     else if (display_isTouched() && adc_timer == adc_settle_ticks) {
       currentState = pressed_st;
-      display_getTouchedPoint(&touch_x, &touch_y, &touch_z);
-
+      readFilteredPoint();
+      postEvent(TOUCHSCREEN_EVENT_PRESS);
     }
     // Otherwise, continue waiting for ADC to settle in this state
     else {
@@ -90,10 +108,20 @@ void touchscreen_tick() {
     // If the touchscreen stops being touched, return to waiting state
     if (!display_isTouched()) {
       currentState = waiting_st;
+      postEvent(TOUCHSCREEN_EVENT_RELEASE);
     }
-    // Otherwise, stay in this state
+    // Otherwise, stay in this state, and report the touch if it has moved
     else {
       currentState = pressed_st;
+      uint16_t last_x = touch_x, last_y = touch_y;
+      readFilteredPoint();
+      if (abs(touch_x - last_x) > TOUCHSCREEN_MOVE_THRESHOLD ||
+          abs(touch_y - last_y) > TOUCHSCREEN_MOVE_THRESHOLD) {
+        postEvent(TOUCHSCREEN_EVENT_MOVE);
+      } else {
+        touch_x = last_x;
+        touch_y = last_y;
+      }
     }
     break;
 
@@ -162,8 +190,67 @@ display_point_t touchscreen_get_location() {
   return touchedCoords;
 }
 
+// Take the oldest event from the event queue.
+bool touchscreen_getEvent(touchscreen_event_t *event) {
+  if (eventHead == eventTail)
+    return false;
+  atomic_thread_fence(memory_order_acquire);
+  *event = events[eventHead & QUEUE_INDEX_MASK];
+
+  // Finish reading the slot before handing it back to the ISR
+  atomic_thread_fence(memory_order_release);
+  eventHead++;
+  return true;
+}
+
+// Return the number of events dropped because the queue was full.
+uint32_t touchscreen_getDroppedEventCount() { return droppedEvents; }
+
 /***********HELPER FUNCTIONS************/
 
+// Sort a few values in place (insertion sort).
+static void sortSamples(int16_t samples[], uint8_t count) {
+  for (uint8_t i = 1; i < count; i++) {
+    int16_t value = samples[i];
+    int8_t j = i - 1;
+    for (; j >= 0 && samples[j] > value; j--)
+      samples[j + 1] = samples[j];
+    samples[j + 1] = value;
+  }
+}
+
+// Read several samples from the touch controller and keep the median x and y
+// (taken separately), which throws away the odd wild sample that averaging
+// would smear into the result.
+static void readFilteredPoint() {
+  int16_t xs[TOUCHSCREEN_FILTER_SAMPLES];
+  int16_t ys[TOUCHSCREEN_FILTER_SAMPLES];
+  for (uint8_t i = 0; i < TOUCHSCREEN_FILTER_SAMPLES; i++)
+    display_getTouchedPoint(&xs[i], &ys[i], &touch_z);
+
+  sortSamples(xs, TOUCHSCREEN_FILTER_SAMPLES);
+  sortSamples(ys, TOUCHSCREEN_FILTER_SAMPLES);
+  touch_x = xs[TOUCHSCREEN_FILTER_SAMPLES / 2];
+  touch_y = ys[TOUCHSCREEN_FILTER_SAMPLES / 2];
+}
+
+// Add an event at the current touch location to the queue.
+static void postEvent(touchscreen_event_type_t type) {
+  if (eventTail - eventHead == TOUCHSCREEN_EVENT_QUEUE_SIZE) {
+    droppedEvents++;
+    return;
+  }
+  touchscreen_event_t *event = &events[eventTail & QUEUE_INDEX_MASK];
+  event->type = type;
+  event->location.x = touch_x;
+  event->location.y = touch_y;
+  event->time = timestamp_now();
+
+  // Publish the event only once it has been written
+  atomic_thread_fence(memory_order_release);
+  eventTail++;
+}
+
 // All printed messages for states are provided here
 #define WAITING_ST_MSG "waiting_st\n"
 #define ADC_SETTLING_ST_MSG "adc_settling_st\n"
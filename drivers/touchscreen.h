@@ -2,6 +2,19 @@
 #define TOUCHSCREEN
 
 #include "display.h"
+#include "timestamp.h"
+#include <stdbool.h>
+
+// Number of samples read from the touch controller for each filtered point;
+// the point is their median
+#define TOUCHSCREEN_FILTER_SAMPLES 5
+
+// A press has to move more than this many pixels (in x or y) to be reported as
+// a move, so noise doesn't show up as moves
+#define TOUCHSCREEN_MOVE_THRESHOLD 3
+
+// Number of events that can wait in the queue (a power of two)
+#define TOUCHSCREEN_EVENT_QUEUE_SIZE 16
 
 // Status of the touchscreen
 typedef enum {
@@ -10,6 +23,21 @@ typedef enum {
   TOUCHSCREEN_RELEASED // Touchscreen has been released, but not acknowledged
 } touchscreen_status_t;
 
+// Kind of touchscreen event
+typedef enum {
+  TOUCHSCREEN_EVENT_PRESS,  // The screen has been touched
+  TOUCHSCREEN_EVENT_MOVE,   // The touch has moved
+  TOUCHSCREEN_EVENT_RELEASE // The touch has been lifted
+} touchscreen_event_type_t;
+
+// A touchscreen event, with the (filtered) location of the touch and the time
+// it was seen
+typedef struct {
+  touchscreen_event_type_t type;
+  display_point_t location;
+  timestamp_t time;
+} touchscreen_event_t;
+
 // Initialize the touchscreen driver state machine, with a given tick period (in
 // seconds).
 void touchscreen_init(double period_seconds);
@@ -28,4 +56,13 @@ void touchscreen_ack_touch();
 // Get the (x,y) location of the last touchscreen touch
 display_point_t touchscreen_get_location();
 
+// Take the oldest event from the event queue. Returns false if there is none.
+// The tick (usually run from an ISR) fills the queue, so a game can handle
+// every touch whenever it gets to it instead of checking the status every
+// tick. Events are dropped if the queue is full.
+bool touchscreen_getEvent(touchscreen_event_t *event);
+
+// Return the number of events dropped because the queue was full.
+uint32_t touchscreen_getDroppedEventCount();
+
 #endif /* TOUCHSCREEN */
@@ -45,7 +45,8 @@ void gpioTest_buttons() {
   // Print a rectangle to the display corresponding to each button being
   // pressed until all buttons are being pressed at the same time
   while (buttons != ALL_BUTTONS_PRESSED) {
-    buttons = buttons_read();
+    // Sleep until the buttons change, if wakeups are enabled
+    buttons = buttons_waitForChange(buttons_prev);
 
     // RECTANGLE FOR BUTTON 0:
     // Print a white rectangle if button 0 has been pressed
@@ -137,7 +138,8 @@ void gpioTest_switches() {
   // Turn on each switch's corresponding LED until all switches are on at the
   // same time
   while (switches != ALL_SWITCHES_ON) {
-    switches = switches_read();
+    // Sleep until the switches change, if wakeups are enabled
+    switches = switches_waitForChange(switches);
     leds_write(switches);
   }
 
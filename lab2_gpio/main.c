@@ -9,14 +9,43 @@ source code for personal or educational use.
 For questions, contact Brad Hutchings or Jeff Goeders, https://ece.byu.edu/
 */
 
+#include <stdbool.h>
+#include <stdio.h>
+
 #include "drivers/buttons.h"
 #include "drivers/switches.h"
+#include "idle.h"
+#include "interrupts.h"
+#include "intervalTimer.h"
 
 #include "gpioTest.h"
 
+// Period of the timer that wakes the CPU to read the GPIO again when the
+// buttons and switches have no interrupts of their own
+#define SAMPLE_PERIOD_S 0.01
+
+// The sampling timer's interrupt only has to wake the CPU
+static void sample_isr() { intervalTimer_ackInterrupt(INTERVAL_TIMER_0); }
+
 // Run switches and buttons runTest functions
 int main() {
+  interrupts_init();
+
+  // Sleep between GPIO changes. Without GPIO interrupts, a timer wakes the CPU
+  // to look again.
+  bool buttonWakeups = buttons_enableWakeups();
+  bool switchWakeups = switches_enableWakeups();
+  if (!buttonWakeups || !switchWakeups) {
+    interrupts_register(INTERVAL_TIMER_0_INTERRUPT_IRQ, sample_isr);
+    interrupts_irq_enable(INTERVAL_TIMER_0_INTERRUPT_IRQ);
+    intervalTimer_initCountDown(INTERVAL_TIMER_0, SAMPLE_PERIOD_S);
+    intervalTimer_enableInterrupt(INTERVAL_TIMER_0);
+    intervalTimer_start(INTERVAL_TIMER_0);
+  }
+
+  idle_resetStats();
   gpioTest_switches();
   gpioTest_buttons();
+  idle_printStats();
   return 0;
 }
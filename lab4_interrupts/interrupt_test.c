@@ -1,3 +1,4 @@
+#include "idle.h"
 #include "interrupt_test.h"
 #include "interrupts.h"
 #include "intervalTimer.h"
@@ -64,9 +65,9 @@ void interrupt_test_run() {
   intervalTimer_start(TIMER_1);
   intervalTimer_start(TIMER_2);
 
-  // Loop forever blinking leds
+  // Loop forever blinking leds, sleeping between interrupts
   while (1)
-    ;
+    idle_wait();
 }
 
 /***********HELPER FUNCTIONS************/
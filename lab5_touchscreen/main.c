@@ -1,6 +1,7 @@
 #include <stdio.h>
 
 #include "armInterrupts.h"
+#include "idle.h"
 #include "interrupts.h"
 #include "intervalTimer.h"
 #include "touchscreen.h"
@@ -95,7 +96,8 @@ int main() {
   intervalTimer_start(INTERVAL_TIMER_0);
   interrupts_irq_enable(INTERVAL_TIMER_0_INTERRUPT_IRQ);
 
-  while (1) {
-  }
+  // Everything runs in the ISR, so sleep between interrupts
+  while (1)
+    idle_wait();
   return 0;
 }
\ No newline at end of file
@@ -16,6 +16,7 @@ For questions, contact Brad Hutchings or Jeff Goeders, https://ece.byu.edu/
 #include <string.h>
 
 #include "display.h"
+#include "textField.h"
 #include "utils.h"
 
 // Startup with this time.
@@ -127,6 +128,9 @@ static uint8_t currentSeconds = STARTUP_SECONDS;
 static uint8_t currentMinutes = STARTUP_MINUTES;
 static uint8_t currentHours = STARTUP_HOURS;
 
+// Remembers what is on screen so only changed digits get redrawn.
+static textField_t clockTextField;
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////// Local Functions /////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -148,6 +152,11 @@ void clockDisplay_init() {
   // Draw the buttons.
   drawUpDownButtons(CLOCK_DISPLAY_BUTTON_COLOR);
 
+  // The clock digits live in a single text field.
+  textField_init(&clockTextField, CLOCK_DISPLAY_ORIGIN_X,
+                 CLOCK_DISPLAY_ORIGIN_Y, CLOCKDISPLAY_TEXT_SIZE,
+                 CLOCK_FOREGROUND_COLOR, CLOCK_BACKGROUND_COLOR);
+
   // Force a draw of the clock display (true = force).
   updateTimeDisplay(FORCE_REDRAW);
 }
@@ -211,13 +220,10 @@ void clockDisplay_advanceTimeOneSecond() {
 ///////////////////////////// Helper Function Definitions /////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-// Updates the time display with latest time, making sure to update only those
+// Updates the time display with latest time. The text field only redraws the
 // digits that have changed since the last update. if forceUpdateAll is true,
 // update all digits.
 static void updateTimeDisplay(bool forceUpdateAll) {
-  // Keep this between invocations.
-  static char currentClockDisplayString[CLOCK_TOTAL_CHAR_COUNT + 1];
-
   // This gets updated each time.
   char nextClockDisplayString[CLOCK_TOTAL_CHAR_COUNT + 1];
 
@@ -231,30 +237,12 @@ static void updateTimeDisplay(bool forceUpdateAll) {
   sprintf(nextClockDisplayString, "%2hd:%02hd:%02hd", currentHours,
           currentMinutes, currentSeconds);
 
-  // Loop through each character
-  for (uint8_t i = 0; i < CLOCK_TOTAL_CHAR_COUNT; i++) {
-    // Redraw any character that has changed.
-    if (nextClockDisplayString[i] != currentClockDisplayString[i] ||
-        forceUpdateAll) {
-      // First, erase the character by drawing as background.
-      display_drawChar(CLOCK_DISPLAY_ORIGIN_X +
-                           (i * DISPLAY_CHAR_WIDTH * CLOCKDISPLAY_TEXT_SIZE),
-                       CLOCK_DISPLAY_ORIGIN_Y, nextClockDisplayString[i],
-                       CLOCK_BACKGROUND_COLOR, CLOCK_BACKGROUND_COLOR,
-                       CLOCKDISPLAY_TEXT_SIZE);
-
-      // Now, draw the character by drawing as foreground.
-      display_drawChar(CLOCK_DISPLAY_ORIGIN_X +
-                           (i * DISPLAY_CHAR_WIDTH * CLOCKDISPLAY_TEXT_SIZE),
-                       CLOCK_DISPLAY_ORIGIN_Y, nextClockDisplayString[i],
-                       CLOCK_FOREGROUND_COLOR, CLOCK_BACKGROUND_COLOR,
-                       CLOCKDISPLAY_TEXT_SIZE);
-
-      // Copy characters from the next string into the current string to prep
-      // for next call.
-      currentClockDisplayString[i] = nextClockDisplayString[i];
-    }
-  }
+  // Everything currently on screen is stale, draw it all again.
+  if (forceUpdateAll)
+    textField_invalidate(&clockTextField);
+
+  // Characters are drawn opaque, so the old digit is overwritten in one pass.
+  textField_draw(&clockTextField, nextClockDisplayString);
 }
 
 // Increments/decrement value, with given minValue and maxValue.
@@ -17,22 +17,14 @@ For questions, contact Brad Hutchings or Jeff Goeders, https://ece.byu.edu/
 #include "clockDisplay.h"
 #include "interrupts.h"
 #include "intervalTimer.h"
+#include "scheduler.h"
 #include "touchscreen.h"
 
 #define TICK_PERIOD 50E-3
 #define ONE_SECOND 1.0
 
-// Interrupt function for state machine ticks
-void isr() {
-  intervalTimer_ackInterrupt(INTERVAL_TIMER_0);
-  clockControl_tick();
-  touchscreen_tick();
-}
-
-// Interrupt function triggered every second to update the time
-void isr_1s() {
-  intervalTimer_ackInterrupt(INTERVAL_TIMER_1);
-
+// Task run every second to update the time
+void advanceTime_tick() {
   touchscreen_status_t ts_status = touchscreen_get_status();
   if (ts_status != TOUCHSCREEN_PRESSED)
     clockDisplay_advanceTimeOneSecond();
@@ -47,26 +39,22 @@ int main() {
   clockControl_init(TICK_PERIOD);
   touchscreen_init(TICK_PERIOD);
 
-  // Set up two timer interrupts:
-  // Timer 0: Tick timer
-  // Timer 1: One second interrupt to advance clock
+  // Every tick function runs from the scheduler, off timer 0. Keeping the time
+  // and reading the touchscreen can't be dropped; the control state machine
+  // can be, if the display ever falls behind.
   interrupts_init();
-  interrupts_register(INTERVAL_TIMER_0_INTERRUPT_IRQ, isr);
-  interrupts_register(INTERVAL_TIMER_1_INTERRUPT_IRQ, isr_1s);
+  interrupts_register(INTERVAL_TIMER_0_INTERRUPT_IRQ, scheduler_isr);
   interrupts_irq_enable(INTERVAL_TIMER_0_INTERRUPT_IRQ);
-  interrupts_irq_enable(INTERVAL_TIMER_1_INTERRUPT_IRQ);
-
-  // Configure the Timers
-  intervalTimer_initCountDown(INTERVAL_TIMER_0, TICK_PERIOD);
-  intervalTimer_initCountDown(INTERVAL_TIMER_1, ONE_SECOND);
-
-  intervalTimer_enableInterrupt(INTERVAL_TIMER_0);
-  intervalTimer_enableInterrupt(INTERVAL_TIMER_1);
 
-  intervalTimer_start(INTERVAL_TIMER_0);
-  intervalTimer_start(INTERVAL_TIMER_1);
+  scheduler_init(INTERVAL_TIMER_0, TICK_PERIOD);
+  scheduler_addTask("touchscreen", touchscreen_tick, TICK_PERIOD,
+                    SCHEDULER_PRIORITY_HIGH);
+  scheduler_addTask("clockControl", clockControl_tick, TICK_PERIOD,
+                    SCHEDULER_PRIORITY_NORMAL);
+  scheduler_addTask("advanceTime", advanceTime_tick, ONE_SECOND,
+                    SCHEDULER_PRIORITY_HIGH);
 
-  while (1)
-    ;
+  // Run the tasks forever, sleeping in between
+  scheduler_run(0);
   return 0;
 }
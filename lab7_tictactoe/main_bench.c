@@ -0,0 +1,128 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "minimax.h"
+#include "ticTacToe.h"
+
+#ifdef HEADLESS
+#include <time.h>
+#else
+#include "intervalTimer.h"
+
+// Free-running timer used as a clock
+#define BENCH_TIMER INTERVAL_TIMER_0
+#endif
+
+// Each engine searches every position this many times
+#define BENCH_REPEATS 5
+
+// Number of positions searched: the empty board, plus each first move by X
+#define BENCH_POSITIONS                                                        \
+  (1 + TICTACTOE_BOARD_ROWS * TICTACTOE_BOARD_COLUMNS)
+
+static tictactoe_board_t positions[BENCH_POSITIONS];
+static tictactoe_location_t moves[BENCH_POSITIONS];
+static minimax_score_t scores[BENCH_POSITIONS];
+
+// How each engine's results are checked against the first engine's
+typedef enum {
+  CHECK_NONE,            // First engine, record the results
+  CHECK_SCORES,          // Scores must match
+  CHECK_SCORES_AND_MOVES // Scores and moves must match
+} check_t;
+
+// Return the time in seconds since an arbitrary start
+static double now() {
+#ifdef HEADLESS
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+  return intervalTimer_getTotalDurationInSeconds(BENCH_TIMER);
+#endif
+}
+
+// Fill the positions array
+static void initPositions() {
+  minimax_initBoard(&positions[0]);
+  for (uint8_t i = 1; i < BENCH_POSITIONS; i++) {
+    minimax_initBoard(&positions[i]);
+    positions[i].squares[(i - 1) / TICTACTOE_BOARD_COLUMNS]
+                        [(i - 1) % TICTACTOE_BOARD_COLUMNS] = MINIMAX_X_SQUARE;
+  }
+}
+
+// Search every position with the given engine and print nodes/second. The
+// first engine run records its results, later engines are checked against
+// them.
+static void runBench(const char *name, minimax_engine_t engine, check_t check) {
+  uint64_t nodes = 0;
+  uint32_t depths = 0;
+  bool resultsMatch = true;
+
+  minimax_setEngine(engine);
+  double start = now();
+
+  for (uint8_t repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+    for (uint8_t i = 0; i < BENCH_POSITIONS; i++) {
+      // X moves first on the empty board, O answers every other position
+      tictactoe_location_t move =
+          minimax_computeNextMove(&positions[i], i == 0);
+      nodes += minimax_getNodeCount();
+      depths += minimax_getDepth();
+
+      if (check == CHECK_NONE) {
+        moves[i] = move;
+        scores[i] = minimax_getScore();
+        continue;
+      }
+      if (minimax_getScore() != scores[i])
+        resultsMatch = false;
+      if (check == CHECK_SCORES_AND_MOVES &&
+          (move.row != moves[i].row || move.column != moves[i].column))
+        resultsMatch = false;
+    }
+  }
+
+  // Only the alpha-beta engine reports a depth, the others search to the end
+  double seconds = now() - start;
+  printf("%-10s %10llu nodes %9.3f s %12.0f nodes/s %10.1f us/move %4.1f "
+         "plies%s\n",
+         name, (unsigned long long)nodes, seconds, nodes / seconds,
+         seconds * 1e6 / (BENCH_REPEATS * BENCH_POSITIONS),
+         (double)depths / (BENCH_REPEATS * BENCH_POSITIONS),
+         resultsMatch ? "" : "  RESULTS DIFFER");
+}
+
+// Benchmark the minimax engines. The parallel engine uses as many cores as the
+// build has (see taskRunner.h), so on the board it matches alphabeta less the
+// cost of splitting the root. The 3x3 tree is searched to the end by every
+// engine. Larger boards (built with a different TICTACTOE_BOARD_ROWS etc.) are
+// far too big for the exhaustive engines, so only alpha-beta runs, within the
+// default time budget.
+int main() {
+  printf("Minimax benchmark: %dx%d board, %d in a row, %d positions x %d "
+         "repeats\n",
+         TICTACTOE_BOARD_ROWS, TICTACTOE_BOARD_COLUMNS, TICTACTOE_WIN_LENGTH,
+         BENCH_POSITIONS, BENCH_REPEATS);
+
+#ifndef HEADLESS
+  intervalTimer_initCountUp(BENCH_TIMER);
+  intervalTimer_start(BENCH_TIMER);
+#endif
+  initPositions();
+
+#if TICTACTOE_BOARD_ROWS * TICTACTOE_BOARD_COLUMNS <= 9
+  runBench("array", MINIMAX_ENGINE_ARRAY, CHECK_NONE);
+  runBench("bitboard", MINIMAX_ENGINE_BITBOARD, CHECK_SCORES_AND_MOVES);
+  runBench("alphabeta", MINIMAX_ENGINE_ALPHABETA, CHECK_SCORES);
+  runBench("parallel", MINIMAX_ENGINE_PARALLEL, CHECK_SCORES);
+  runBench("book", MINIMAX_ENGINE_BOOK, CHECK_SCORES);
+#else
+  printf("Time budget: %.1f ms/move\n", MINIMAX_DEFAULT_TIME_BUDGET * 1e3);
+  runBench("alphabeta", MINIMAX_ENGINE_ALPHABETA, CHECK_NONE);
+  runBench("parallel", MINIMAX_ENGINE_PARALLEL, CHECK_NONE);
+#endif
+  return 0;
+}
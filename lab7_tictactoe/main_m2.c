@@ -11,31 +11,21 @@ For questions, contact Brad Hutchings or Jeff Goeders, https://ece.byu.edu/
 
 #include <stdio.h>
 
+#include "idle.h"
 #include "interrupts.h"
 #include "intervalTimer.h"
+#include "scheduler.h"
 #include "ticTacToeControl.h"
 #include "ticTacToeDisplay.h"
 #include "touchscreen.h"
-#include "utils.h"
 
 #define TICK_PERIOD 50E-3
 #define TOTAL_SECONDS 30
-#define MAX_INTERRUPT_COUNT (TOTAL_SECONDS / TICK_PERIOD)
+#define TOTAL_TICKS (TOTAL_SECONDS / TICK_PERIOD)
 
 #define MILESTONE1_MESSAGE "Running testBoards()\n"
 #define MILESTONE2_MESSAGE "Running tic-tac-toe game\n"
 
-// Keep track of how many times interrupt routing is called,
-// and how many times ISR is run
-volatile uint32_t interrupt_count;
-uint32_t isr_run_count;
-
-// Interrupt flag method
-volatile bool interrupt_flag;
-
-// Interrupt Service Routing to run tick functions using flag method
-static void isr();
-
 int main() {
   printf(MILESTONE2_MESSAGE);
 
@@ -43,47 +33,26 @@ int main() {
   ticTacToeControl_init(TICK_PERIOD);
   touchscreen_init(TICK_PERIOD);
 
+  // Both tick functions run from the scheduler, off timer 0. The touchscreen
+  // is read first; the game's tick, which can take a while when the computer
+  // moves, shows up as overruns in the stats.
   interrupts_init();
+  interrupts_register(INTERVAL_TIMER_0_INTERRUPT_IRQ, scheduler_isr);
   interrupts_irq_enable(INTERVAL_TIMER_0_INTERRUPT_IRQ);
-  interrupts_register(INTERVAL_TIMER_0_INTERRUPT_IRQ, isr);
-  intervalTimer_initCountDown(INTERVAL_TIMER_0, TICK_PERIOD);
-  intervalTimer_enableInterrupt(INTERVAL_TIMER_0);
-
-  interrupt_count = 0;
-  isr_run_count = 0;
-  interrupt_flag = false;
 
-  intervalTimer_start(INTERVAL_TIMER_0);
+  scheduler_init(INTERVAL_TIMER_0, TICK_PERIOD);
+  scheduler_addTask("touchscreen", touchscreen_tick, TICK_PERIOD,
+                    SCHEDULER_PRIORITY_HIGH);
+  scheduler_addTask("ticTacToeControl", ticTacToeControl_tick, TICK_PERIOD,
+                    SCHEDULER_PRIORITY_NORMAL);
 
-  while (1) {
-    // Wait for interrupt flag
-    while (!interrupt_flag) {
-      utils_sleep();
-    }
-    interrupt_flag = false;
-
-    // Increment counter
-    isr_run_count++;
-
-    // Run tick functions
-    ticTacToeControl_tick();
-    touchscreen_tick();
-
-    // Stop after predetermined amount of ticks
-    if (interrupt_count >= MAX_INTERRUPT_COUNT)
-      break;
-  }
+  // Run for a predetermined amount of ticks
+  idle_resetStats();
+  scheduler_run(TOTAL_TICKS);
 
   // Stop interrupts and print counts
   intervalTimer_stop(INTERVAL_TIMER_0);
-  printf("interrupt count: %d\n", interrupt_count);
-  printf("isr invocation count: %d\n", isr_run_count);
+  scheduler_printStats();
+  idle_printStats();
   return 0;
 }
-
-// Interrupt routine
-static void isr() {
-  intervalTimer_ackInterrupt(INTERVAL_TIMER_0);
-  interrupt_count++;
-  interrupt_flag = true;
-}
\ No newline at end of file
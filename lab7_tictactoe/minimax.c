@@ -1,13 +1,76 @@
+#include <stdatomic.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#ifdef HEADLESS
+#include <time.h>
+#endif
 
 #include "minimax.h"
+#include "openingBook.h"
+#include "taskRunner.h"
 #include "ticTacToe.h"
+#ifndef HEADLESS
+#include "timestamp.h"
+#endif
+#include "ticTacToeBitboard.h"
+#include "transpositionTable.h"
+
+// Alpha-beta works on minimax scores times SEARCH_SCALE, which leaves room
+// below one point for the heuristic evaluation used when the search stops
+// before the end of the game
+#define SEARCH_SCALE 256
+
+// Larger than any score, used as the initial alpha-beta window
+#define SCORE_INFINITY INT16_MAX
+
+// lastSquare of the root, which has no last move
+#define NO_LAST_SQUARE -1
+
+// Searches check the clock every this many visited positions, so reading it
+// costs little next to the search
+#define BUDGET_CHUNK 256
+
+// Node count of one alpha-beta search. Every core searching part of the tree
+// has its own.
+typedef struct {
+  uint32_t nodes; // Positions visited
+} search_t;
+
+// A root move searched as a task by the parallel engine
+typedef struct {
+  search_t search;
+  ticTacToeBitboard_t board;   // Position after the move
+  bool is_Xs_turn;             // Player to move after the move
+  uint8_t square;              // The move (bit index)
+  uint8_t remaining;           // Plies to search below the move
+  minimax_score_t alpha, beta; // Search window
+  minimax_score_t score;       // Result
+} rootJob_t;
 
 // Global variable containing the best possible move
 static tictactoe_location_t choice;
 
+// Engine used by minimax_computeNextMove()
+static minimax_engine_t engine = MINIMAX_ENGINE_BOOK;
+
+// Number of positions visited by the last search, and the score it found
+static uint32_t nodeCount = 0;
+static minimax_score_t rootScore = 0;
+
+// Alpha-beta time budget, and the state of the current iterative deepening.
+// The deadline and the abort flag are shared by all cores.
+static double timeBudget = MINIMAX_DEFAULT_TIME_BUDGET;
+static double searchDeadline; // clockSeconds() at which the search stops
+static bool abortAllowed = false; // Search may be stopped by the budget
+static atomic_bool searchAborted;
+static uint8_t searchDepth = 0; // Depth of the last complete search
+static ticTacToeBitboard_mask_t rootMove = 0;
+
+// Root moves of the parallel engine, and whether the task runner is started
+static rootJob_t rootJobs[TICTACTOEBITBOARD_SQUARES];
+static bool taskRunnerStarted = false;
+
 /***********HELPER FUNCTIONS************/
 
 // Recursive algorithm for determining whether the current player
@@ -22,6 +85,8 @@ static minimax_score_t minimax(tictactoe_board_t board, bool is_Xs_turn,
 
   minimax_score_t score;
 
+  nodeCount++;
+
   /*-----------------BASE CASE------------------*/
 
   score = minimax_computeBoardScore(&board, is_Xs_turn);
@@ -113,6 +178,386 @@ static minimax_score_t minimax(tictactoe_board_t board, bool is_Xs_turn,
   return bestScore;
 }
 
+// Bitboard version of minimax(). It searches the same tree in the same order
+// and picks the same move, but each position is two 9-bit masks passed in
+// registers, empty squares are found with bit tricks and the end-of-game test
+// is a handful of mask compares.
+static minimax_score_t minimaxBitboard(ticTacToeBitboard_t board,
+                                       bool is_Xs_turn, uint8_t depth) {
+  minimax_score_t score;
+
+  nodeCount++;
+
+  /*-----------------BASE CASE------------------*/
+
+  score = ticTacToeBitboard_computeScore(&board, is_Xs_turn);
+
+  // Bias the score by the depth of the recursion, as in minimax()
+  if (minimax_isGameOver(score))
+    return is_Xs_turn ? score + depth : score - depth;
+
+  /*-----------------RECURSION CASE------------------*/
+
+  ticTacToeBitboard_mask_t empty =
+      ~(board.x | board.o) & TICTACTOEBITBOARD_ALL_SQUARES;
+  ticTacToeBitboard_mask_t bestMove = 0;
+  minimax_score_t bestScore = 0;
+
+  // Simulate play on each empty square, lowest square first
+  for (; empty; empty = TICTACTOEBITBOARD_CLEAR_LOWEST(empty)) {
+    ticTacToeBitboard_mask_t move = TICTACTOEBITBOARD_LOWEST_SQUARE(empty);
+    ticTacToeBitboard_t next = board;
+    if (is_Xs_turn)
+      next.x |= move;
+    else
+      next.o |= move;
+
+    score = minimaxBitboard(next, !is_Xs_turn, depth + 1);
+
+    // X wants the highest score and O the lowest. Ties go to the later move,
+    // like minimax().
+    if (!bestMove || (is_Xs_turn ? score >= bestScore : score <= bestScore)) {
+      bestScore = score;
+      bestMove = move;
+    }
+  }
+
+  // Only the move at the root is returned to the caller
+  if (depth == 0)
+    choice = ticTacToeBitboard_toLocation(bestMove);
+
+  return bestScore;
+}
+
+// Return the time in seconds since an arbitrary start. The headless build's
+// timestamps run in virtual time, where computation takes none, so the search
+// is timed with the host clock there.
+static double clockSeconds() {
+#ifdef HEADLESS
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+  return timestamp_toSeconds(timestamp_now());
+#endif
+}
+
+// Count a visited position and check the time budget. Returns false once the
+// search has to stop.
+static bool countNode(search_t *search) {
+  search->nodes++;
+  if (search->nodes % BUDGET_CHUNK == 0 && abortAllowed && timeBudget &&
+      clockSeconds() > searchDeadline)
+    atomic_store(&searchAborted, true);
+  return !atomic_load_explicit(&searchAborted, memory_order_relaxed);
+}
+
+// Score of a position right after a move to lastSquare, as
+// ticTacToeBitboard_computeScore() would return it. Only the lines through
+// the square just taken can have been completed.
+static minimax_score_t scoreAfterMove(ticTacToeBitboard_t *board,
+                                      bool is_Xs_turn, uint8_t lastSquare) {
+  ticTacToeBitboard_mask_t lastPlayer = is_Xs_turn ? board->o : board->x;
+  if (ticTacToeBitboard_isWinThrough(lastPlayer, lastSquare))
+    return is_Xs_turn ? MINIMAX_O_WINNING_SCORE : MINIMAX_X_WINNING_SCORE;
+
+  if ((board->x | board->o) == TICTACTOEBITBOARD_ALL_SQUARES)
+    return MINIMAX_DRAW_SCORE;
+  return MINIMAX_NOT_ENDGAME;
+}
+
+// Heuristic score of a position the search stops at, kept below one point so
+// it never outweighs a known result
+static minimax_score_t evaluateHorizon(ticTacToeBitboard_t *board) {
+  int16_t value = ticTacToeBitboard_evaluate(board);
+  if (value >= SEARCH_SCALE)
+    return SEARCH_SCALE - 1;
+  if (value <= -SEARCH_SCALE)
+    return -(SEARCH_SCALE - 1);
+  return value;
+}
+
+// Alpha-beta version of minimaxBitboard(). It returns the same score for the
+// root (times SEARCH_SCALE), but stops searching a move as soon as it can't
+// change the result (alpha is the score X is already sure of, beta the score O
+// is sure of), and remembers every position it searches in the transposition
+// table. The root may pick a different move than the exhaustive engines when
+// moves tie. Positions `remaining` plies below the root are scored with the
+// heuristic instead of being searched.
+static minimax_score_t minimaxAlphaBeta(search_t *search,
+                                        ticTacToeBitboard_t board,
+                                        bool is_Xs_turn, uint8_t depth,
+                                        uint8_t remaining, int8_t lastSquare,
+                                        minimax_score_t alpha,
+                                        minimax_score_t beta) {
+  minimax_score_t score;
+
+  // Out of budget, unwind. The caller throws away this search.
+  if (!countNode(search))
+    return 0;
+
+  /*-----------------BASE CASE------------------*/
+
+  // The root gets the full check, every other position only looks at the
+  // lines through the last move
+  if (lastSquare == NO_LAST_SQUARE)
+    score = ticTacToeBitboard_computeScore(&board, is_Xs_turn);
+  else
+    score = scoreAfterMove(&board, is_Xs_turn, lastSquare);
+
+  // Bias the score by the depth of the recursion, as in minimax()
+  if (minimax_isGameOver(score))
+    return (is_Xs_turn ? score + depth : score - depth) * SEARCH_SCALE;
+
+  if (remaining == 0)
+    return evaluateHorizon(&board);
+
+  ticTacToeBitboard_mask_t empty =
+      ~(board.x | board.o) & TICTACTOEBITBOARD_ALL_SQUARES;
+  ticTacToeBitboard_mask_t mine = is_Xs_turn ? board.x : board.o;
+  ticTacToeBitboard_mask_t theirs = is_Xs_turn ? board.o : board.x;
+
+  // Looking further ahead than the end of the game gives the same result
+  uint8_t emptyCount = ticTacToeBitboard_count(empty);
+  if (remaining > emptyCount)
+    remaining = emptyCount;
+
+  // A move that wins right away is usually the best move, so it is tried
+  // first. It can't simply be returned: with depth-biased scores a late draw
+  // can outscore a win for O.
+  ticTacToeBitboard_mask_t winningMove = TICTACTOEBITBOARD_LOWEST_SQUARE(
+      ticTacToeBitboard_getWinningSquares(mine, theirs));
+
+  // Every position in one search is at a fixed depth from the root, so stored
+  // depth-biased scores stay valid until the next search clears the table.
+  // A stored score is only used if it was searched at least as deep, but the
+  // stored move is always worth trying first. The root itself is always
+  // searched, since its move is needed.
+  ticTacToeBitboard_t canonical;
+  uint8_t symmetry = ticTacToeBitboard_canonicalize(&board, &canonical);
+  ticTacToeBitboard_mask_t storedMove = 0;
+  transpositionTable_entry_t entry;
+  if (transpositionTable_probe(&canonical, &entry)) {
+    storedMove = ticTacToeBitboard_transform(
+        TICTACTOEBITBOARD_BIT(entry.bestSquare),
+        ticTacToeBitboard_inverseSymmetry(symmetry));
+
+    if (depth > 0 && entry.depth >= remaining) {
+      if (entry.bound == TRANSPOSITIONTABLE_EXACT)
+        return entry.score;
+      if (entry.bound == TRANSPOSITIONTABLE_LOWER && entry.score > alpha)
+        alpha = entry.score;
+      if (entry.bound == TRANSPOSITIONTABLE_UPPER && entry.score < beta)
+        beta = entry.score;
+      if (alpha >= beta)
+        return entry.score;
+    }
+  }
+
+  /*-----------------RECURSION CASE------------------*/
+
+  minimax_score_t alphaIn = alpha;
+  minimax_score_t betaIn = beta;
+  minimax_score_t bestScore = is_Xs_turn ? -SCORE_INFINITY : SCORE_INFINITY;
+  ticTacToeBitboard_mask_t bestMove = 0;
+  const uint8_t *moveOrder = ticTacToeBitboard_getMoveOrder();
+
+  // Winning move (or else the stored move) first, then the fixed move order
+  ticTacToeBitboard_mask_t firstMove = winningMove ? winningMove : storedMove;
+  for (int8_t i = -1; i < TICTACTOEBITBOARD_SQUARES; i++) {
+    ticTacToeBitboard_mask_t move =
+        i < 0 ? firstMove : TICTACTOEBITBOARD_BIT(moveOrder[i]);
+    if (!(empty & move) || (i >= 0 && move == firstMove))
+      continue;
+
+    ticTacToeBitboard_t next = board;
+    if (is_Xs_turn)
+      next.x |= move;
+    else
+      next.o |= move;
+
+    score = minimaxAlphaBeta(search, next, !is_Xs_turn, depth + 1,
+                             remaining - 1, __builtin_ctzll(move), alpha, beta);
+    if (atomic_load_explicit(&searchAborted, memory_order_relaxed))
+      return 0;
+
+    // X raises alpha, O lowers beta
+    if (is_Xs_turn ? score > bestScore : score < bestScore) {
+      bestScore = score;
+      bestMove = move;
+    }
+    if (is_Xs_turn && score > alpha)
+      alpha = score;
+    if (!is_Xs_turn && score < beta)
+      beta = score;
+
+    // The other player won't allow this position, stop looking
+    if (alpha >= beta)
+      break;
+  }
+
+  // A score outside the window is only a bound on the true score
+  transpositionTable_bound_t bound = TRANSPOSITIONTABLE_EXACT;
+  if (bestScore <= alphaIn)
+    bound = TRANSPOSITIONTABLE_UPPER;
+  else if (bestScore >= betaIn)
+    bound = TRANSPOSITIONTABLE_LOWER;
+  transpositionTable_store(
+      &canonical, bestScore, bound, remaining,
+      __builtin_ctzll(ticTacToeBitboard_transform(bestMove, symmetry)));
+
+  // Only the move at the root is returned to the caller
+  if (depth == 0)
+    rootMove = bestMove;
+
+  return bestScore;
+}
+
+// Task run by the parallel engine: search one root move
+static void searchRootJob(void *arg) {
+  rootJob_t *job = arg;
+  job->search.nodes = 0;
+  job->score =
+      minimaxAlphaBeta(&job->search, job->board, job->is_Xs_turn, 1,
+                       job->remaining, job->square, job->alpha, job->beta);
+}
+
+// Fill rootJobs with the moves from the root, in the order they should be
+// searched: a winning move first, then the fixed move order. Returns the
+// number of moves.
+static uint8_t initRootJobs(ticTacToeBitboard_t *board, bool is_Xs_turn) {
+  ticTacToeBitboard_mask_t empty =
+      ~(board->x | board->o) & TICTACTOEBITBOARD_ALL_SQUARES;
+  ticTacToeBitboard_mask_t mine = is_Xs_turn ? board->x : board->o;
+  ticTacToeBitboard_mask_t theirs = is_Xs_turn ? board->o : board->x;
+  ticTacToeBitboard_mask_t winningMove = TICTACTOEBITBOARD_LOWEST_SQUARE(
+      ticTacToeBitboard_getWinningSquares(mine, theirs));
+  const uint8_t *moveOrder = ticTacToeBitboard_getMoveOrder();
+  uint8_t count = 0;
+
+  for (int8_t i = -1; i < TICTACTOEBITBOARD_SQUARES; i++) {
+    ticTacToeBitboard_mask_t move =
+        i < 0 ? winningMove : TICTACTOEBITBOARD_BIT(moveOrder[i]);
+    if (!(empty & move) || (i >= 0 && move == winningMove))
+      continue;
+
+    rootJob_t *job = &rootJobs[count++];
+    job->board = *board;
+    if (is_Xs_turn)
+      job->board.x |= move;
+    else
+      job->board.o |= move;
+    job->is_Xs_turn = !is_Xs_turn;
+    job->square = __builtin_ctzll(move);
+  }
+  return count;
+}
+
+// Root-split version of minimaxAlphaBeta() for one search depth. The first
+// move is searched on this core to get a score to beat, then the other moves
+// are handed to the task runner, each searched with a window that only asks
+// whether it beats the first. Returns the root's score (times SEARCH_SCALE)
+// and moves the best job to the front of rootJobs, so the next, deeper search
+// starts with it.
+static minimax_score_t searchParallelRoot(bool is_Xs_turn, uint8_t jobCount,
+                                          uint8_t remaining) {
+  rootJob_t *first = &rootJobs[0];
+  first->remaining = remaining;
+  first->alpha = -SCORE_INFINITY;
+  first->beta = SCORE_INFINITY;
+  searchRootJob(first);
+  nodeCount += first->search.nodes;
+
+  // A move that doesn't beat the first fails with a bound, which is enough to
+  // rule it out
+  for (uint8_t i = 1; i < jobCount; i++) {
+    rootJob_t *job = &rootJobs[i];
+    job->remaining = remaining;
+    job->alpha = is_Xs_turn ? first->score : -SCORE_INFINITY;
+    job->beta = is_Xs_turn ? SCORE_INFINITY : first->score;
+    taskRunner_submit(searchRootJob, job);
+  }
+  taskRunner_runAll();
+
+  // Ties go to the move searched first
+  uint8_t best = 0;
+  for (uint8_t i = 1; i < jobCount; i++) {
+    nodeCount += rootJobs[i].search.nodes;
+    minimax_score_t score = rootJobs[i].score;
+    if (is_Xs_turn ? score > rootJobs[best].score
+                   : score < rootJobs[best].score)
+      best = i;
+  }
+
+  rootJob_t bestJob = rootJobs[best];
+  memmove(&rootJobs[1], &rootJobs[0], best * sizeof(rootJob_t));
+  rootJobs[0] = bestJob;
+  return bestJob.score;
+}
+
+// Run minimaxAlphaBeta() one ply deeper at a time until the end of the game
+// is reached or the time budget runs out, and keep the move of the last
+// search that finished. Without a budget the whole tree is searched at once.
+// With parallel set, the root moves are split between the cores. Returns the
+// root's minimax score.
+static minimax_score_t searchAlphaBeta(ticTacToeBitboard_t board,
+                                       bool is_Xs_turn, bool parallel) {
+  uint8_t emptyCount = TICTACTOEBITBOARD_SQUARES -
+                       ticTacToeBitboard_count(board.x | board.o);
+  search_t search = {.nodes = 0};
+  uint8_t jobCount = 0;
+  minimax_score_t score = 0;
+
+  // A finished game has no move to search
+  minimax_score_t endScore =
+      ticTacToeBitboard_computeScore(&board, is_Xs_turn);
+  if (minimax_isGameOver(endScore))
+    return endScore;
+
+  transpositionTable_clear();
+#ifndef HEADLESS
+  timestamp_init(); // Cheap, and makes sure the clock is running
+#endif
+  searchDeadline = clockSeconds() + timeBudget;
+  atomic_store(&searchAborted, false);
+  searchDepth = 0;
+
+  if (parallel) {
+    if (!taskRunnerStarted) {
+      taskRunner_init();
+      taskRunnerStarted = true;
+    }
+    jobCount = initRootJobs(&board, is_Xs_turn);
+  }
+
+  for (uint8_t depth = timeBudget ? 1 : emptyCount; depth <= emptyCount;
+       depth++) {
+    // The first search always finishes, so there is a move to return
+    abortAllowed = searchDepth > 0;
+    minimax_score_t result;
+    if (parallel) {
+      nodeCount++; // The root
+      result = searchParallelRoot(is_Xs_turn, jobCount, depth - 1);
+    } else {
+      result = minimaxAlphaBeta(&search, board, is_Xs_turn, 0, depth,
+                                NO_LAST_SQUARE, -SCORE_INFINITY,
+                                SCORE_INFINITY);
+    }
+    if (atomic_load(&searchAborted))
+      break;
+
+    if (parallel)
+      rootMove = TICTACTOEBITBOARD_BIT(rootJobs[0].square);
+    score = result;
+    searchDepth = depth;
+    choice = ticTacToeBitboard_toLocation(rootMove);
+  }
+  nodeCount += search.nodes;
+
+  // Heuristic scores are below one point and round to a draw
+  return score / SEARCH_SCALE;
+}
+
 // Defining characters to print in the board
 #define MINIMAX_EMPTY_SQUARE_CHAR ' '
 #define MINIMAX_O_SQUARE_CHAR 'O'
@@ -170,13 +615,54 @@ static void printBoard(tictactoe_board_t *board) {
 tictactoe_location_t minimax_computeNextMove(tictactoe_board_t *board,
                                              bool is_Xs_turn) {
   uint8_t depth = 0;
-
-  // Best move will be saved in the "choice" global
-  minimax(*board, is_Xs_turn, depth);
+  minimax_engine_t engineUsed = engine;
+
+  nodeCount = 0;
+  searchDepth = 0;
+
+  // Positions from a real game are all in the book
+  if (engine == MINIMAX_ENGINE_BOOK &&
+      openingBook_lookup(board, is_Xs_turn, &choice, &rootScore))
+    return choice;
+
+  // Best move will be saved in the "choice" global. The book falls back to
+  // alpha-beta, in parallel if there is a second core to run it on.
+  if (engine == MINIMAX_ENGINE_BOOK)
+    engineUsed = taskRunner_getCoreCount() > 1 ? MINIMAX_ENGINE_PARALLEL
+                                               : MINIMAX_ENGINE_ALPHABETA;
+
+  if (engineUsed == MINIMAX_ENGINE_ALPHABETA ||
+      engineUsed == MINIMAX_ENGINE_PARALLEL) {
+    ticTacToeBitboard_t bitboard;
+    ticTacToeBitboard_fromBoard(board, &bitboard);
+    rootScore = searchAlphaBeta(bitboard, is_Xs_turn,
+                                engineUsed == MINIMAX_ENGINE_PARALLEL);
+  } else if (engine == MINIMAX_ENGINE_BITBOARD) {
+    ticTacToeBitboard_t bitboard;
+    ticTacToeBitboard_fromBoard(board, &bitboard);
+    rootScore = minimaxBitboard(bitboard, is_Xs_turn, depth);
+  } else {
+    rootScore = minimax(*board, is_Xs_turn, depth);
+  }
 
   return choice;
 }
 
+// Select the search engine used by minimax_computeNextMove().
+void minimax_setEngine(minimax_engine_t newEngine) { engine = newEngine; }
+
+// Return the number of positions visited by the last search.
+uint32_t minimax_getNodeCount() { return nodeCount; }
+
+// Return the score of the position searched by the last search.
+minimax_score_t minimax_getScore() { return rootScore; }
+
+// Set the longest the alpha-beta engine may search per move.
+void minimax_setTimeBudget(double seconds) { timeBudget = seconds; }
+
+// Return the number of plies the last alpha-beta search looked ahead.
+uint8_t minimax_getDepth() { return searchDepth; }
+
 // Returns the score of the board.
 // This returns one of 4 values: MINIMAX_X_WINNING_SCORE,
 // MINIMAX_O_WINNING_SCORE, MINIMAX_DRAW_SCORE, MINIMAX_NOT_ENDGAME
@@ -189,125 +675,10 @@ tictactoe_location_t minimax_computeNextMove(tictactoe_board_t *board,
 // you don't need to look for 'O's, and vice-versa.
 minimax_score_t minimax_computeBoardScore(tictactoe_board_t *board,
                                           bool is_Xs_turn) {
-  // Only look for wins from the previous player
-  tictactoe_square_state_t prevPlayer;
-  prevPlayer = is_Xs_turn ? MINIMAX_O_SQUARE : MINIMAX_X_SQUARE;
-
-  /*-----------------ROW WINS------------------*/
-
-  // Look for row wins, start iterating through rows
-  for (uint8_t rowPos = 0; rowPos < TICTACTOE_BOARD_ROWS; rowPos++) {
-    bool winFoundInRow = true;
-
-    // If all squares in the row are occupied by prevPlayer, then they won
-    for (uint8_t colPos = 0; colPos < TICTACTOE_BOARD_COLUMNS; colPos++) {
-      // If the current square isn't occupied by prevPlayer, then there is not a
-      // win in this row
-      if (board->squares[rowPos][colPos] != prevPlayer) {
-        winFoundInRow = false;
-        break;
-      }
-    }
-
-    // If all three squares in the row matched, previous player won
-    if (winFoundInRow && prevPlayer == MINIMAX_O_SQUARE) {
-      return MINIMAX_O_WINNING_SCORE;
-    } else if (winFoundInRow && prevPlayer == MINIMAX_X_SQUARE) {
-      return MINIMAX_X_WINNING_SCORE;
-    }
-  }
-
-  /*------------------COLUMN WINS-----------------*/
-
-  // Look for column wins, start iterating through columns
-  for (uint8_t colPos = 0; colPos < TICTACTOE_BOARD_COLUMNS; colPos++) {
-    bool winFoundInCol = true;
-
-    // If all squares in the column are occupied by prevPlayer, then they won
-    for (uint8_t rowPos = 0; rowPos < TICTACTOE_BOARD_ROWS; rowPos++) {
-      // If the current square isn't occupied by prevPlayer, then there is not a
-      // win in this column
-      if (board->squares[rowPos][colPos] != prevPlayer) {
-        winFoundInCol = false;
-        break;
-      }
-    }
-
-    // If all three squares in the column matched, previous player won
-    if (winFoundInCol && prevPlayer == MINIMAX_O_SQUARE) {
-      return MINIMAX_O_WINNING_SCORE;
-    } else if (winFoundInCol && prevPlayer == MINIMAX_X_SQUARE) {
-      return MINIMAX_X_WINNING_SCORE;
-    }
-  }
-
-  /*----------------DIAGONAL WIN 1-------------------*/
-
-  uint8_t colPos;
-  bool diagonalWinFound1 = true;
-
-  // Look for top-right to bottom-left diagonal win
-  for (uint8_t rowPos = 0; rowPos < TICTACTOE_BOARD_ROWS; rowPos++) {
-    colPos = rowPos;
-
-    // If the current square isn't occupied by prevPlayer, then there is not a
-    // win in this diagonal
-    if (board->squares[rowPos][colPos] != prevPlayer) {
-      diagonalWinFound1 = false;
-      break;
-    }
-  }
-
-  // If all three squares in the column matched, previous player won
-  if (diagonalWinFound1 && prevPlayer == MINIMAX_O_SQUARE) {
-    return MINIMAX_O_WINNING_SCORE;
-  } else if (diagonalWinFound1 && prevPlayer == MINIMAX_X_SQUARE) {
-    return MINIMAX_X_WINNING_SCORE;
-  }
-
-  /*----------------DIAGONAL WIN 2-------------------*/
-
-  bool diagonalWinFound2 = true;
-
-  // Look for bottom-right to top-left diagonal win
-  for (uint8_t rowPos = 0; rowPos < TICTACTOE_BOARD_ROWS; rowPos++) {
-    colPos = TICTACTOE_BOARD_ROWS - rowPos - 1;
-
-    // If the current square isn't occupied by prevPlayer, then there is not a
-    // win in this diagonal
-    if (board->squares[rowPos][colPos] != prevPlayer) {
-      diagonalWinFound2 = false;
-      break;
-    }
-  }
-
-  // If all three squares in the column matched, previous player won
-  if (diagonalWinFound2 && prevPlayer == MINIMAX_O_SQUARE) {
-    return MINIMAX_O_WINNING_SCORE;
-  } else if (diagonalWinFound2 && prevPlayer == MINIMAX_X_SQUARE) {
-    return MINIMAX_X_WINNING_SCORE;
-  }
-
-  /*----------------TIE OR MIDGAME-------------------*/
-
-  // Iterate through all squares on the board
-  // * If any empty squares, the game is not over
-  // * Otherwise, the game is a tie
-
-  // Iterate through each row of the board
-  for (uint8_t rowPos = 0; rowPos < TICTACTOE_BOARD_ROWS; rowPos++) {
-    // Iterate through each column of the board
-    for (uint8_t colPos = 0; colPos < TICTACTOE_BOARD_COLUMNS; colPos++) {
-      // If there is an empty square, game is not over
-      if (board->squares[rowPos][colPos] == MINIMAX_EMPTY_SQUARE) {
-        return MINIMAX_NOT_ENDGAME;
-      }
-    }
-  }
-
-  // If this point has been reached, all squares are occupied and no one has
-  // won. The game is a draw.
-  return MINIMAX_DRAW_SCORE;
+  // Checking every winning line works for any board size and win length
+  ticTacToeBitboard_t bitboard;
+  ticTacToeBitboard_fromBoard(board, &bitboard);
+  return ticTacToeBitboard_computeScore(&bitboard, is_Xs_turn);
 }
 
 // Init the board to all empty squares.
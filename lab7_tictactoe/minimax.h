@@ -17,15 +17,44 @@ For questions, contact Brad Hutchings or Jeff Goeders, https://ece.byu.edu/
 
 #include "ticTacToe.h"
 
-// Scoring for minimax.
-#define MINIMAX_X_WINNING_SCORE 10  // This means that X will win.
-#define MINIMAX_O_WINNING_SCORE -10 // This means that O will win.
-#define MINIMAX_DRAW_SCORE 0        // Nobody wins.
-#define MINIMAX_NOT_ENDGAME -1      // Not an end-game.
+// Scoring for minimax. Scores are biased by the search depth, so a win (X
+// wins for the positive score, O for the negative one) is worth one more than
+// the number of squares: 10 on the 3x3 board.
+#define MINIMAX_X_WINNING_SCORE                                                \
+  (TICTACTOE_BOARD_ROWS * TICTACTOE_BOARD_COLUMNS + 1)
+#define MINIMAX_O_WINNING_SCORE (-MINIMAX_X_WINNING_SCORE)
+#define MINIMAX_DRAW_SCORE 0   // Nobody wins.
+#define MINIMAX_NOT_ENDGAME -1 // Not an end-game.
+
+// Longest the alpha-beta engine searches per move, in seconds, 0 for no
+// limit. The 3x3 tree is always searched to the end; larger boards are
+// searched one ply deeper at a time until the time runs out, and the last
+// complete search is used. The default leaves over half of a 50 ms
+// ticTacToeControl tick for the rest of the tick.
+#if TICTACTOE_BOARD_ROWS * TICTACTOE_BOARD_COLUMNS <= 9
+#define MINIMAX_DEFAULT_TIME_BUDGET 0.0
+#else
+#define MINIMAX_DEFAULT_TIME_BUDGET 20.0E-3
+#endif
 
 // Define a score type.
 typedef int16_t minimax_score_t;
 
+// Search engines available to minimax_computeNextMove(). All of them find the
+// best score; the array and bitboard engines search the whole tree and return
+// the same move, the others may return a different move of equal score. The
+// older engines are kept for comparison.
+typedef enum {
+  MINIMAX_ENGINE_ARRAY,     // Recursion over tictactoe_board_t copies
+  MINIMAX_ENGINE_BITBOARD,  // Recursion over X/O bit masks
+  MINIMAX_ENGINE_ALPHABETA, // Bit masks with pruning, a transposition table
+                            // and iterative deepening
+  MINIMAX_ENGINE_PARALLEL,  // Alpha-beta with the root moves split between
+                            // the cores (see taskRunner.h)
+  MINIMAX_ENGINE_BOOK // Precomputed opening book, parallel alpha-beta if the
+                      // position isn't in it (default, only 3x3 has a book)
+} minimax_engine_t;
+
 // This routine is not recursive but will invoke the recursive minimax function.
 // You will call this function from the controlling state machine that you will
 // implement in a later milestone. It computes the row and column of the next
@@ -61,4 +90,26 @@ void minimax_initBoard(tictactoe_board_t *board);
 // Determine that the game is over by looking at the score.
 bool minimax_isGameOver(minimax_score_t score);
 
+// Select the search engine used by minimax_computeNextMove().
+void minimax_setEngine(minimax_engine_t engine);
+
+// Return the number of positions visited by the last call to
+// minimax_computeNextMove().
+uint32_t minimax_getNodeCount();
+
+// Return the score of the board searched by the last call to
+// minimax_computeNextMove(), assuming perfect play from there on. A search
+// that stopped before the end of the game returns MINIMAX_DRAW_SCORE unless it
+// found a forced result.
+minimax_score_t minimax_getScore();
+
+// Set the longest the alpha-beta engine may search per move, in seconds (0
+// for no limit). The clock is checked as the search runs, so a move takes
+// about this long whatever the board and CPU, plus the first one-ply search,
+// which always finishes.
+void minimax_setTimeBudget(double seconds);
+
+// Return the number of plies the last alpha-beta search looked ahead.
+uint8_t minimax_getDepth();
+
 #endif /* MINIMAX */
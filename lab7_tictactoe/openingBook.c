@@ -0,0 +1,65 @@
+#include "openingBook.h"
+#include "ticTacToeBitboard.h"
+
+#define SQUARE_MASK ((1u << OPENINGBOOK_SQUARE_BITS) - 1)
+#define SCORE_MASK ((1u << OPENINGBOOK_SCORE_BITS) - 1)
+
+/***********HELPER FUNCTIONS************/
+
+#if OPENINGBOOK_PRESENT
+// Return the index of the entry with the given key, or -1 if there is none
+static int32_t findEntry(uint32_t key) {
+  int32_t low = 0;
+  int32_t high = openingBook_entryCount - 1;
+
+  while (low <= high) {
+    int32_t middle = (low + high) / 2;
+    uint32_t middleKey = openingBook_entries[middle] >> OPENINGBOOK_KEY_SHIFT;
+    if (middleKey == key)
+      return middle;
+    if (middleKey < key)
+      low = middle + 1;
+    else
+      high = middle - 1;
+  }
+  return -1;
+}
+#endif
+
+/***********HEADER FUNCTIONS************/
+
+// Look up the best move for the player to move.
+bool openingBook_lookup(tictactoe_board_t *board, bool is_Xs_turn,
+                        tictactoe_location_t *move, minimax_score_t *score) {
+#if !OPENINGBOOK_PRESENT
+  return false;
+#else
+  ticTacToeBitboard_t bitboard;
+  ticTacToeBitboard_t canonical;
+  ticTacToeBitboard_fromBoard(board, &bitboard);
+
+  // X moves first, so it is X's turn exactly when the counts are equal
+  uint8_t xCount = ticTacToeBitboard_count(bitboard.x);
+  uint8_t oCount = ticTacToeBitboard_count(bitboard.o);
+  if (is_Xs_turn != (xCount == oCount))
+    return false;
+
+  uint8_t symmetry = ticTacToeBitboard_canonicalize(&bitboard, &canonical);
+  int32_t index = findEntry(ticTacToeBitboard_toKey(&canonical));
+  if (index < 0)
+    return false;
+
+  // The book's move is for the canonical board, turn it back to this board
+  uint32_t entry = openingBook_entries[index];
+  ticTacToeBitboard_mask_t square = ticTacToeBitboard_transform(
+      TICTACTOEBITBOARD_BIT(entry & SQUARE_MASK),
+      ticTacToeBitboard_inverseSymmetry(symmetry));
+  if (square & (bitboard.x | bitboard.o))
+    return false;
+
+  *move = ticTacToeBitboard_toLocation(square);
+  *score = (int16_t)((entry >> OPENINGBOOK_SQUARE_BITS) & SCORE_MASK) -
+           OPENINGBOOK_SCORE_BIAS;
+  return true;
+#endif
+}
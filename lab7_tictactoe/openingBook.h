@@ -0,0 +1,43 @@
+#ifndef OPENINGBOOK
+#define OPENINGBOOK
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "minimax.h"
+#include "ticTacToe.h"
+
+// Each book entry packs a canonical position key (ticTacToeBitboard_toKey() of
+// the board from ticTacToeBitboard_canonicalize()), the score of the position
+// and the best move's square in the canonical board into one word:
+//   key << 9 | (score + OPENINGBOOK_SCORE_BIAS) << 4 | square
+#define OPENINGBOOK_SQUARE_BITS 4
+#define OPENINGBOOK_SCORE_BITS 5
+#define OPENINGBOOK_SCORE_BIAS 16
+#define OPENINGBOOK_KEY_SHIFT (OPENINGBOOK_SQUARE_BITS + OPENINGBOOK_SCORE_BITS)
+#define OPENINGBOOK_ENTRY(key, score, square)                                  \
+  (((uint32_t)(key) << OPENINGBOOK_KEY_SHIFT) |                                \
+   ((uint32_t)((score) + OPENINGBOOK_SCORE_BIAS) << OPENINGBOOK_SQUARE_BITS) | \
+   (square))
+
+// The book is generated for the standard board: 3x3, three in a row.
+#define OPENINGBOOK_PRESENT                                                    \
+  (TICTACTOE_BOARD_ROWS == 3 && TICTACTOE_BOARD_COLUMNS == 3 &&                \
+   TICTACTOE_WIN_LENGTH == 3)
+
+// Perfect-play opening book covering every position that can come up in a
+// game, with rotations and reflections merged. The entries live in
+// openingBookData.c, which is generated on the host by lab7_bookgen.elf
+// (openingBookGenerator.c) and sorted by key so a lookup is a binary search.
+extern const uint32_t openingBook_entries[];
+extern const uint16_t openingBook_entryCount;
+
+// Look up the best move for the player to move. Returns false if the position
+// isn't in the book (for example, a board that can't happen in a real game,
+// is_Xs_turn doesn't match the number of X's and O's, or any position on a
+// board other than 3x3), in which case the caller must search. On success the
+// move and the position's minimax score are written to move and score.
+bool openingBook_lookup(tictactoe_board_t *board, bool is_Xs_turn,
+                        tictactoe_location_t *move, minimax_score_t *score);
+
+#endif /* OPENINGBOOK */
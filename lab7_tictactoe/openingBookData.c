@@ -0,0 +1,113 @@
+// Generated by lab7_bookgen.elf (openingBookGenerator.c), do not edit.
+
+#include "openingBook.h"
+
+const uint16_t openingBook_entryCount = 627;
+
+const uint32_t openingBook_entries[] = {
+    0x000000e8, 0x000002d4, 0x000004d7, 0x000020d8, 0x000404c7, 0x00040958,
+    0x00040ca6, 0x000414a4, 0x000418a4, 0x000420c7, 0x000424b7, 0x000428a6,
+    0x00044152, 0x000444b7, 0x00044968, 0x000450b4, 0x000460b3, 0x00048964,
+    0x0004c0a2, 0x000540b6, 0x00060156, 0x000604a7, 0x00060965, 0x000620a6,
+    0x000640a2, 0x00080356, 0x00080aa4, 0x00081154, 0x00081366, 0x000818a4,
+    0x00082158, 0x00082368, 0x00083165, 0x000850b4, 0x00088158, 0x00088363,
+    0x000888b4, 0x000890b0, 0x0008a162, 0x0008c0b4, 0x000900c8, 0x000902a8,
+    0x000910b8, 0x000920b8, 0x000980b8, 0x000a8167, 0x000c1975, 0x000c2996,
+    0x000c3195, 0x000c3988, 0x000c4998, 0x000c5194, 0x000c5988, 0x000c6193,
+    0x000c6988, 0x000c8994, 0x000c90a2, 0x000c9894, 0x000ca192, 0x000cb072,
+    0x000cc172, 0x000cc988, 0x000cd072, 0x000ce072, 0x000d0978, 0x000d1152,
+    0x000d1968, 0x000d20b2, 0x000d28c6, 0x000d3072, 0x000d4152, 0x000d4968,
+    0x000d5072, 0x000d6072, 0x000d8198, 0x000d8988, 0x000d9072, 0x000da072,
+    0x000dc072, 0x000e0995, 0x000e1152, 0x000e1965, 0x000e2172, 0x000e2987,
+    0x000e3072, 0x000e4192, 0x000e5072, 0x000e6072, 0x000e8197, 0x000e8987,
+    0x000e9072, 0x000ea072, 0x000ec072, 0x000f0196, 0x000f0986, 0x000f1072,
+    0x000f2072, 0x000f4072, 0x00141574, 0x00142597, 0x00143195, 0x00143588,
+    0x00145194, 0x00145494, 0x00148577, 0x001490a1, 0x00149498, 0x0014a0b1,
+    0x0014a4c7, 0x0014b071, 0x0014c0b1, 0x0014c4c7, 0x0014d071, 0x0014e071,
+    0x00150594, 0x001510a1, 0x00151494, 0x00152191, 0x00153071, 0x00155071,
+    0x00158198, 0x00158588, 0x00159071, 0x0015a071, 0x0015c071, 0x00168197,
+    0x001684c7, 0x00169071, 0x0016a071, 0x00280b78, 0x00282398, 0x00282996,
+    0x00282b88, 0x00284378, 0x00284998, 0x00284ac8, 0x00286178, 0x002862c8,
+    0x00286988, 0x00288994, 0x00288a94, 0x0028c178, 0x0028c2c8, 0x0028c988,
+    0x0028e0c2, 0x00294178, 0x002942c8, 0x002948c8, 0x00296090, 0x002a0394,
+    0x002a0995, 0x002a0b87, 0x002a2190, 0x002a2987, 0x002a4192, 0x002a4387,
+    0x002a6187, 0x002a8987, 0x002ac187, 0x002b4186, 0x002c6998, 0x002cc998,
+    0x002ce192, 0x002d4998, 0x002d6088, 0x002d6876, 0x002dc988, 0x002e2996,
+    0x002e6192, 0x002e8997, 0x002ec197, 0x002ee072, 0x002f4196, 0x002f6076,
+    0x00300774, 0x00302398, 0x00302597, 0x00302788, 0x003042b8, 0x003044b7,
+    0x003046c8, 0x003060b7, 0x003062c8, 0x003064c7, 0x00308378, 0x00308577,
+    0x00308695, 0x0030a178, 0x0030a2c8, 0x0030a4c7, 0x0030c0b8, 0x0030c2c8,
+    0x0030c4c8, 0x0030e0c8, 0x00310378, 0x00310594, 0x00310694, 0x00312191,
+    0x00312388, 0x003140b6, 0x003142c8, 0x003144c4, 0x003160c1, 0x00318198,
+    0x003182c8, 0x00318588, 0x0031a188, 0x0031c0c8, 0x00320394, 0x00320577,
+    0x00320694, 0x00322190, 0x00322587, 0x003240b6, 0x003242c4, 0x00324496,
+    0x00326090, 0x00328197, 0x00328387, 0x003284c7, 0x0032a187, 0x0032c0c7,
+    0x00330196, 0x00330386, 0x00330586, 0x00332186, 0x00334096, 0x00346597,
+    0x0034a597, 0x0034c577, 0x0034e0d1, 0x0034e4e7, 0x00354594, 0x00356191,
+    0x00358598, 0x0035a198, 0x0035c198, 0x0035c588, 0x0035e071, 0x00362597,
+    0x003644d6, 0x00366087, 0x00366476, 0x00368597, 0x0036a197, 0x0036a4e7,
+    0x0036c197, 0x0036c4e7, 0x0036e071, 0x00370596, 0x00372196, 0x00374196,
+    0x00374476, 0x00376076, 0x00386398, 0x0038a398, 0x0038c378, 0x0038e0d0,
+    0x0038e2e8, 0x00392398, 0x00394378, 0x003960d0, 0x003962e8, 0x00398398,
+    0x0039a198, 0x0039a2e8, 0x0039c198, 0x0039c2e8, 0x0039e070, 0x003a4394,
+    0x003a6190, 0x003a8397, 0x003aa197, 0x003ac197, 0x003ac387, 0x003ae070,
+    0x003b0396, 0x003b2196, 0x003b4196, 0x003b4386, 0x003b6070, 0x004002c8,
+    0x004004c7, 0x004006a2, 0x00400aa1, 0x004014a0, 0x004018a1, 0x004050b8,
+    0x004088b7, 0x00440cb8, 0x004414b8, 0x004418b8, 0x00441c78, 0x004444b8,
+    0x00444998, 0x00444c78, 0x004450a8, 0x00445478, 0x00445878, 0x00448978,
+    0x00448c78, 0x0044c178, 0x0044c478, 0x0044c878, 0x0044d078, 0x00454178,
+    0x00454478, 0x00454878, 0x004604b6, 0x00460995, 0x00460cc5, 0x004614c7,
+    0x004618c5, 0x00464192, 0x004644c2, 0x00465092, 0x00468987, 0x0046c187,
+    0x00474186, 0x00480ab7, 0x00481396, 0x004818b7, 0x00481a77, 0x004850a7,
+    0x00485277, 0x00488393, 0x004888b7, 0x00488a77, 0x00489190, 0x00489877,
+    0x0048c0b7, 0x0048c277, 0x0048c877, 0x0048d077, 0x00490376, 0x00490ac8,
+    0x00491176, 0x004912c6, 0x004918c8, 0x00495092, 0x00498198, 0x00498388,
+    0x004988c8, 0x00499188, 0x0049c0c8, 0x004a8197, 0x004a8277, 0x004a9077,
+    0x004c5998, 0x004c9888, 0x004cc998, 0x004cd088, 0x004cd878, 0x004d1978,
+    0x004d4998, 0x004d5088, 0x004d5878, 0x004d8998, 0x004d9198, 0x004d9878,
+    0x004dc198, 0x004dc878, 0x004dd078, 0x004e1995, 0x004e5192, 0x004e8997,
+    0x004e9197, 0x004e9877, 0x004ec197, 0x004ed077, 0x004f0996, 0x004f1196,
+    0x004f1986, 0x004f4196, 0x004f5072, 0x00545488, 0x005494d8, 0x0054c4d8,
+    0x0054d088, 0x0054d478, 0x00551488, 0x00555088, 0x00555478, 0x00558598,
+    0x00559198, 0x00559478, 0x0055c198, 0x0055c478, 0x0055d078, 0x00568597,
+    0x00569197, 0x005694e7, 0x0056d071, 0x00684b98, 0x00688a88, 0x0068c2d7,
+    0x0068c998, 0x0068ca77, 0x00694378, 0x00694998, 0x00694ae8, 0x0069c8e8,
+    0x006a0b95, 0x006a4392, 0x006a8997, 0x006a8a77, 0x006ac197, 0x006ac277,
+    0x006b4196, 0x006b4386, 0x006dc998, 0x007046d6, 0x007086d5, 0x0070c2d8,
+    0x0070c4d8, 0x0070c6e8, 0x00710688, 0x007142d6, 0x007144d6, 0x00714676,
+    0x00718398, 0x00718598, 0x00718675, 0x0071c198, 0x0071c2e8, 0x0071c4e8,
+    0x00720687, 0x007242d6, 0x007244d6, 0x00724676, 0x00728397, 0x00728597,
+    0x00728675, 0x0072c197, 0x0072c2e7, 0x0072c4e7, 0x00730396, 0x00730596,
+    0x00730676, 0x00734196, 0x00734276, 0x00734476, 0x0075c598, 0x0076c597,
+    0x00774596, 0x0079c398, 0x007ac397, 0x007b4396, 0x00a00792, 0x00a00b91,
+    0x00a02398, 0x00a02597, 0x00a02788, 0x00a02b88, 0x00a08374, 0x00a08574,
+    0x00a08674, 0x00a08994, 0x00a08a74, 0x00a08c74, 0x00a0a388, 0x00a0a588,
+    0x00a10594, 0x00a10674, 0x00a10a74, 0x00a42d97, 0x00a48d94, 0x00a4a597,
+    0x00a50d94, 0x00a52996, 0x00a58598, 0x00a58998, 0x00a58c74, 0x00a5a198,
+    0x00a60c87, 0x00a62597, 0x00a62996, 0x00a62c76, 0x00a68597, 0x00a68997,
+    0x00a68c74, 0x00a6a197, 0x00a6a587, 0x00a70596, 0x00a70996, 0x00a70c76,
+    0x00a72196, 0x00a72876, 0x00a82b98, 0x00a88b94, 0x00a8a398, 0x00a90b74,
+    0x00a92398, 0x00a92b88, 0x00a98398, 0x00a98998, 0x00a98a74, 0x00a9a198,
+    0x00a9a388, 0x00aa8397, 0x00aa8a74, 0x00aaa197, 0x00af2996, 0x00b6a597,
+    0x01100774, 0x01101574, 0x01101674, 0x01102398, 0x01102597, 0x01102788,
+    0x01103588, 0x01104374, 0x01104574, 0x01104674, 0x01105194, 0x01105274,
+    0x01105474, 0x01106388, 0x01106588, 0x01114274, 0x01120394, 0x01120674,
+    0x01143597, 0x01145594, 0x01146597, 0x01154594, 0x01155474, 0x01156193,
+    0x01161574, 0x01162597, 0x01163587, 0x01164487, 0x01165194, 0x01165474,
+    0x01166193, 0x01166473, 0x01174084, 0x01174474, 0x01176073, 0x01183398,
+    0x01185394, 0x01186398, 0x01191374, 0x01192398, 0x01193195, 0x01193388,
+    0x01194374, 0x01195194, 0x01195274, 0x01196193, 0x01196388, 0x011a1394,
+    0x011a3195, 0x011a4394, 0x011a5194, 0x011a5274, 0x011a6193, 0x011b0394,
+    0x011b1085, 0x011b1274, 0x011b2190, 0x011b3070, 0x011b4084, 0x011b4274,
+    0x011b5074, 0x011b6070, 0x01396398, 0x013b4394, 0x013b6190, 0x01841cd8,
+    0x01842d97, 0x01843597, 0x018438d8, 0x01843ce7, 0x01850d94, 0x01851594,
+    0x018518d8, 0x01851ce4, 0x01852991, 0x018538e1, 0x01860cd3, 0x018618d7,
+    0x01861ce7, 0x018628d3, 0x01862c73, 0x018638e7, 0x01870c73, 0x01881ad8,
+    0x01882b98, 0x01883398, 0x018838d8, 0x01883ae8, 0x01890ad8, 0x018912d8,
+    0x018918d8, 0x01891ae8, 0x01892398, 0x01892ae8, 0x018930d8, 0x018932e8,
+    0x018938e8, 0x018a0b94, 0x018a1394, 0x018a1ae4, 0x018b12e4, 0x018d38f8,
+    0x018e38f7, 0x018f18f4, 0x018f28f3, 0x018f30f2, 0x01963597, 0x01971594,
+    0x01973191, 0x01993398, 0x019b1394, 0x01a92b98, 0x01ab0b94, 0x01ab2990,
+    0x01b30794, 0x01c51cf8, 0x01c61cf7, 0x01c70cf3, 0x01c91af8, 0x01ca1af7,
+    0x01cb12f2, 0x02aa8b94, 0x05155594,
+};
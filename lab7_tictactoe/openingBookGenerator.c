@@ -0,0 +1,113 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "minimax.h"
+#include "openingBook.h"
+#include "ticTacToeBitboard.h"
+
+_Static_assert(OPENINGBOOK_PRESENT, "The book is only for the 3x3 board");
+
+// Every packed board key is below this
+#define KEY_LIMIT (1u << (2 * TICTACTOEBITBOARD_SQUARES))
+
+// Most book entries, far more than the number of canonical positions
+#define MAX_ENTRIES 2048
+
+// Entries per line in the generated file
+#define ENTRIES_PER_LINE 6
+
+static bool *visited; // Indexed by canonical key
+static uint32_t entries[MAX_ENTRIES];
+static uint16_t entryCount = 0;
+
+// Solve a canonical position with the exhaustive engine and add it to the book
+static void addEntry(ticTacToeBitboard_t *canonical, bool is_Xs_turn) {
+  tictactoe_board_t board;
+  ticTacToeBitboard_toBoard(canonical, &board);
+
+  tictactoe_location_t move = minimax_computeNextMove(&board, is_Xs_turn);
+  uint8_t square = move.row * TICTACTOE_BOARD_COLUMNS + move.column;
+
+  if (entryCount == MAX_ENTRIES) {
+    fprintf(stderr, "Too many positions, raise MAX_ENTRIES\n");
+    exit(1);
+  }
+  entries[entryCount++] = OPENINGBOOK_ENTRY(
+      ticTacToeBitboard_toKey(canonical), minimax_getScore(), square);
+}
+
+// Visit every position reachable from this one, adding each new canonical
+// position where the game isn't over yet
+static void visit(ticTacToeBitboard_t board, bool is_Xs_turn) {
+  ticTacToeBitboard_t canonical;
+
+  if (minimax_isGameOver(ticTacToeBitboard_computeScore(&board, is_Xs_turn)))
+    return;
+
+  ticTacToeBitboard_canonicalize(&board, &canonical);
+  uint32_t key = ticTacToeBitboard_toKey(&canonical);
+  if (visited[key])
+    return;
+  visited[key] = true;
+  addEntry(&canonical, is_Xs_turn);
+
+  ticTacToeBitboard_mask_t empty =
+      ~(board.x | board.o) & TICTACTOEBITBOARD_ALL_SQUARES;
+  for (; empty; empty = TICTACTOEBITBOARD_CLEAR_LOWEST(empty)) {
+    ticTacToeBitboard_t next = board;
+    if (is_Xs_turn)
+      next.x |= TICTACTOEBITBOARD_LOWEST_SQUARE(empty);
+    else
+      next.o |= TICTACTOEBITBOARD_LOWEST_SQUARE(empty);
+    visit(next, !is_Xs_turn);
+  }
+}
+
+// Sort entries by key (the key is in the high bits)
+static int compareEntries(const void *a, const void *b) {
+  uint32_t first = *(const uint32_t *)a;
+  uint32_t second = *(const uint32_t *)b;
+  return (first > second) - (first < second);
+}
+
+// Generate openingBookData.c: solve every position reachable in a game and
+// write the book to the file named on the command line (or to stdout).
+int main(int argc, char *argv[]) {
+  FILE *out = argc > 1 ? fopen(argv[1], "w") : stdout;
+  if (out == NULL) {
+    perror(argv[1]);
+    return 1;
+  }
+
+  visited = calloc(KEY_LIMIT, sizeof(bool));
+  if (visited == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    return 1;
+  }
+
+  // The book holds the exhaustive search's choices
+  minimax_setEngine(MINIMAX_ENGINE_BITBOARD);
+  ticTacToeBitboard_t empty = {.x = 0, .o = 0};
+  visit(empty, true);
+  qsort(entries, entryCount, sizeof(entries[0]), compareEntries);
+
+  fprintf(out, "// Generated by lab7_bookgen.elf (openingBookGenerator.c), "
+               "do not edit.\n\n");
+  fprintf(out, "#include \"openingBook.h\"\n\n");
+  fprintf(out, "const uint16_t openingBook_entryCount = %u;\n\n", entryCount);
+  fprintf(out, "const uint32_t openingBook_entries[] = {");
+  for (uint16_t i = 0; i < entryCount; i++) {
+    if (i % ENTRIES_PER_LINE == 0)
+      fprintf(out, "\n   ");
+    fprintf(out, " 0x%08x,", entries[i]);
+  }
+  fprintf(out, "\n};\n");
+
+  fprintf(stderr, "%u positions\n", entryCount);
+  free(visited);
+  if (out != stdout)
+    fclose(out);
+  return 0;
+}
@@ -3,9 +3,19 @@
 
 #include <stdint.h>
 
-// Defines the boundaries of the tic-tac-toe board.
+// Defines the boundaries of the tic-tac-toe board, and how many squares in a
+// row, column or diagonal win. The search code works on any size up to 63
+// squares (build with -DTICTACTOE_BOARD_ROWS=5 etc.); the display and control
+// code only draw the 3x3 board.
+#ifndef TICTACTOE_BOARD_ROWS
 #define TICTACTOE_BOARD_ROWS 3
+#endif
+#ifndef TICTACTOE_BOARD_COLUMNS
 #define TICTACTOE_BOARD_COLUMNS 3
+#endif
+#ifndef TICTACTOE_WIN_LENGTH
+#define TICTACTOE_WIN_LENGTH 3
+#endif
 
 // These are the values in the board to represent who is occupying what square.
 typedef enum {
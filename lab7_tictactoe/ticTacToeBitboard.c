@@ -0,0 +1,310 @@
+#include "ticTacToeBitboard.h"
+
+// Directions a line can run in, as (row, column) steps: across, down and both
+// diagonals
+#define DIRECTIONS 4
+static const int8_t rowStep[DIRECTIONS] = {0, 1, 1, 1};
+static const int8_t columnStep[DIRECTIONS] = {1, 0, 1, -1};
+
+// Every winning line, and the lines through each square. Built on first use.
+static ticTacToeBitboard_mask_t winLines[TICTACTOEBITBOARD_WIN_LINES];
+static ticTacToeBitboard_mask_t
+    linesThrough[TICTACTOEBITBOARD_SQUARES]
+                [TICTACTOEBITBOARD_MAX_LINES_PER_SQUARE];
+static uint8_t linesThroughCount[TICTACTOEBITBOARD_SQUARES];
+static uint8_t moveOrder[TICTACTOEBITBOARD_SQUARES];
+static bool tablesBuilt = false;
+
+#if TICTACTOEBITBOARD_SYMMETRIES > 1
+// symmetries[s][mask] is the mask after applying symmetry s
+static ticTacToeBitboard_mask_t
+    symmetries[TICTACTOEBITBOARD_SYMMETRIES][TICTACTOEBITBOARD_ALL_SQUARES + 1];
+#endif
+
+_Static_assert(TICTACTOE_WIN_LENGTH <= TICTACTOE_BOARD_ROWS &&
+                   TICTACTOE_WIN_LENGTH <= TICTACTOE_BOARD_COLUMNS,
+               "A winning line must fit on the board");
+_Static_assert(TICTACTOEBITBOARD_SQUARES < 64, "Board too large for a mask");
+
+/***********HELPER FUNCTIONS************/
+
+#if TICTACTOEBITBOARD_SYMMETRIES > 1
+// Return where symmetry s moves the square at (row, column). Symmetries 0-3
+// rotate by 0, 90, 180 and 270 degrees, 4-7 do the same after a mirror.
+static uint8_t mapSquare(uint8_t s, uint8_t row, uint8_t column) {
+  const uint8_t last = TICTACTOE_BOARD_ROWS - 1;
+
+  if (s >= TICTACTOEBITBOARD_SYMMETRIES / 2)
+    column = last - column;
+
+  // Rotate 90 degrees clockwise once per step
+  for (uint8_t step = 0; step < s % 4; step++) {
+    uint8_t oldRow = row;
+    row = column;
+    column = last - oldRow;
+  }
+  return row * TICTACTOE_BOARD_COLUMNS + column;
+}
+
+// Fill in the symmetries table
+static void buildSymmetries() {
+  for (uint8_t s = 0; s < TICTACTOEBITBOARD_SYMMETRIES; s++) {
+    for (uint32_t mask = 0; mask <= TICTACTOEBITBOARD_ALL_SQUARES; mask++) {
+      ticTacToeBitboard_mask_t mapped = 0;
+      for (uint8_t i = 0; i < TICTACTOEBITBOARD_SQUARES; i++)
+        if (mask & TICTACTOEBITBOARD_BIT(i))
+          mapped |= TICTACTOEBITBOARD_BIT(mapSquare(
+              s, i / TICTACTOE_BOARD_COLUMNS, i % TICTACTOE_BOARD_COLUMNS));
+      symmetries[s][mask] = mapped;
+    }
+  }
+}
+#endif
+
+// Count the squares in a mask with at most a line's worth of squares set. One
+// step per square beats a full popcount on processors without the instruction.
+static uint8_t countLine(ticTacToeBitboard_mask_t mask) {
+  uint8_t count = 0;
+  for (; mask; mask = TICTACTOEBITBOARD_CLEAR_LOWEST(mask))
+    count++;
+  return count;
+}
+
+// Return true if (row, column) is on the board
+static bool onBoard(int8_t row, int8_t column) {
+  return row >= 0 && row < TICTACTOE_BOARD_ROWS && column >= 0 &&
+         column < TICTACTOE_BOARD_COLUMNS;
+}
+
+// Find every winning line, the lines through each square and the move order
+static void buildTables() {
+  uint16_t lineCount = 0;
+
+  // A line starts at every square where TICTACTOE_WIN_LENGTH steps in one
+  // direction stay on the board
+  for (int8_t row = 0; row < TICTACTOE_BOARD_ROWS; row++) {
+    for (int8_t column = 0; column < TICTACTOE_BOARD_COLUMNS; column++) {
+      for (uint8_t d = 0; d < DIRECTIONS; d++) {
+        int8_t lastRow = row + rowStep[d] * (TICTACTOE_WIN_LENGTH - 1);
+        int8_t lastColumn = column + columnStep[d] * (TICTACTOE_WIN_LENGTH - 1);
+        if (!onBoard(lastRow, lastColumn))
+          continue;
+
+        ticTacToeBitboard_mask_t line = 0;
+        for (uint8_t i = 0; i < TICTACTOE_WIN_LENGTH; i++)
+          line |= TICTACTOEBITBOARD_SQUARE(row + rowStep[d] * i,
+                                           column + columnStep[d] * i);
+        winLines[lineCount++] = line;
+      }
+    }
+  }
+
+  // Index the lines by square
+  for (uint8_t square = 0; square < TICTACTOEBITBOARD_SQUARES; square++) {
+    linesThroughCount[square] = 0;
+    for (uint16_t i = 0; i < TICTACTOEBITBOARD_WIN_LINES; i++)
+      if (winLines[i] & TICTACTOEBITBOARD_BIT(square))
+        linesThrough[square][linesThroughCount[square]++] = winLines[i];
+  }
+
+  // Order squares by the number of lines through them (insertion sort, ties
+  // keep the lower square first)
+  for (uint8_t i = 0; i < TICTACTOEBITBOARD_SQUARES; i++) {
+    uint8_t j = i;
+    for (; j > 0 && linesThroughCount[moveOrder[j - 1]] < linesThroughCount[i];
+         j--)
+      moveOrder[j] = moveOrder[j - 1];
+    moveOrder[j] = i;
+  }
+
+#if TICTACTOEBITBOARD_SYMMETRIES > 1
+  buildSymmetries();
+#endif
+  tablesBuilt = true;
+}
+
+/***********HEADER FUNCTIONS************/
+
+// Convert a bitboard into an array board.
+void ticTacToeBitboard_toBoard(ticTacToeBitboard_t *bitboard,
+                               tictactoe_board_t *board) {
+  for (uint8_t row = 0; row < TICTACTOE_BOARD_ROWS; row++) {
+    for (uint8_t column = 0; column < TICTACTOE_BOARD_COLUMNS; column++) {
+      ticTacToeBitboard_mask_t square = TICTACTOEBITBOARD_SQUARE(row, column);
+      if (bitboard->x & square)
+        board->squares[row][column] = MINIMAX_X_SQUARE;
+      else if (bitboard->o & square)
+        board->squares[row][column] = MINIMAX_O_SQUARE;
+      else
+        board->squares[row][column] = MINIMAX_EMPTY_SQUARE;
+    }
+  }
+}
+
+// Convert an array board into a bitboard.
+void ticTacToeBitboard_fromBoard(tictactoe_board_t *board,
+                                 ticTacToeBitboard_t *bitboard) {
+  bitboard->x = 0;
+  bitboard->o = 0;
+
+  for (uint8_t row = 0; row < TICTACTOE_BOARD_ROWS; row++) {
+    for (uint8_t column = 0; column < TICTACTOE_BOARD_COLUMNS; column++) {
+      if (board->squares[row][column] == MINIMAX_X_SQUARE)
+        bitboard->x |= TICTACTOEBITBOARD_SQUARE(row, column);
+      else if (board->squares[row][column] == MINIMAX_O_SQUARE)
+        bitboard->o |= TICTACTOEBITBOARD_SQUARE(row, column);
+    }
+  }
+}
+
+// Return the number of squares set in a mask.
+uint8_t ticTacToeBitboard_count(ticTacToeBitboard_mask_t mask) {
+  return __builtin_popcountll(mask);
+}
+
+// Return true if the squares contain a full winning line.
+bool ticTacToeBitboard_isWin(ticTacToeBitboard_mask_t squares) {
+  if (!tablesBuilt)
+    buildTables();
+
+  for (uint16_t i = 0; i < TICTACTOEBITBOARD_WIN_LINES; i++)
+    if ((squares & winLines[i]) == winLines[i])
+      return true;
+  return false;
+}
+
+// Return true if the squares contain a full winning line through the square.
+bool ticTacToeBitboard_isWinThrough(ticTacToeBitboard_mask_t squares,
+                                    uint8_t square) {
+  if (!tablesBuilt)
+    buildTables();
+
+  const ticTacToeBitboard_mask_t *lines = linesThrough[square];
+  for (uint8_t i = 0; i < linesThroughCount[square]; i++)
+    if ((squares & lines[i]) == lines[i])
+      return true;
+  return false;
+}
+
+// Return the empty squares that would complete a winning line.
+ticTacToeBitboard_mask_t
+ticTacToeBitboard_getWinningSquares(ticTacToeBitboard_mask_t mine,
+                                    ticTacToeBitboard_mask_t theirs) {
+  ticTacToeBitboard_mask_t squares = 0;
+
+  if (!tablesBuilt)
+    buildTables();
+
+  // A line missing just one square, with none of the opponent's in it
+  for (uint16_t i = 0; i < TICTACTOEBITBOARD_WIN_LINES; i++) {
+    ticTacToeBitboard_mask_t missing = winLines[i] & ~mine;
+    if (!(theirs & winLines[i]) && missing &&
+        !TICTACTOEBITBOARD_CLEAR_LOWEST(missing))
+      squares |= missing;
+  }
+  return squares;
+}
+
+// Bitboard version of minimax_computeBoardScore().
+minimax_score_t ticTacToeBitboard_computeScore(ticTacToeBitboard_t *bitboard,
+                                               bool is_Xs_turn) {
+  // Only the player that just moved can have won
+  if (is_Xs_turn && ticTacToeBitboard_isWin(bitboard->o))
+    return MINIMAX_O_WINNING_SCORE;
+  if (!is_Xs_turn && ticTacToeBitboard_isWin(bitboard->x))
+    return MINIMAX_X_WINNING_SCORE;
+
+  // A full board with no winner is a draw
+  if ((bitboard->x | bitboard->o) == TICTACTOEBITBOARD_ALL_SQUARES)
+    return MINIMAX_DRAW_SCORE;
+  return MINIMAX_NOT_ENDGAME;
+}
+
+// Heuristic value of a position for X.
+int16_t ticTacToeBitboard_evaluate(ticTacToeBitboard_t *bitboard) {
+  int16_t value = 0;
+
+  if (!tablesBuilt)
+    buildTables();
+
+  for (uint16_t i = 0; i < TICTACTOEBITBOARD_WIN_LINES; i++) {
+    ticTacToeBitboard_mask_t xs = bitboard->x & winLines[i];
+    ticTacToeBitboard_mask_t os = bitboard->o & winLines[i];
+
+    // A line with both players in it can't be won by either
+    if (!os) {
+      uint8_t count = countLine(xs);
+      value += count * count;
+    } else if (!xs) {
+      uint8_t count = countLine(os);
+      value -= count * count;
+    }
+  }
+  return value;
+}
+
+// Return the squares ordered by the number of winning lines through them.
+const uint8_t *ticTacToeBitboard_getMoveOrder() {
+  if (!tablesBuilt)
+    buildTables();
+  return moveOrder;
+}
+
+// Pack a bitboard of up to 16 squares into a single number.
+uint32_t ticTacToeBitboard_toKey(ticTacToeBitboard_t *bitboard) {
+  return bitboard->x | ((uint32_t)bitboard->o << TICTACTOEBITBOARD_SQUARES);
+}
+
+// Apply one of the board's symmetries to a mask.
+ticTacToeBitboard_mask_t
+ticTacToeBitboard_transform(ticTacToeBitboard_mask_t mask, uint8_t symmetry) {
+#if TICTACTOEBITBOARD_SYMMETRIES > 1
+  if (!tablesBuilt)
+    buildTables();
+  return symmetries[symmetry][mask];
+#else
+  return mask;
+#endif
+}
+
+// Return the symmetry that undoes the given one.
+uint8_t ticTacToeBitboard_inverseSymmetry(uint8_t symmetry) {
+  // Rotations undo each other, and every mirror-then-rotate is its own
+  // inverse
+  if (symmetry < 4)
+    return (4 - symmetry) % 4;
+  return symmetry;
+}
+
+// Find the canonical form of the board.
+uint8_t ticTacToeBitboard_canonicalize(ticTacToeBitboard_t *bitboard,
+                                       ticTacToeBitboard_t *canonical) {
+  uint8_t bestSymmetry = 0;
+  *canonical = *bitboard;
+
+#if TICTACTOEBITBOARD_SYMMETRIES > 1
+  if (!tablesBuilt)
+    buildTables();
+
+  // Smallest O mask, then smallest X mask
+  for (uint8_t s = 1; s < TICTACTOEBITBOARD_SYMMETRIES; s++) {
+    ticTacToeBitboard_t mapped = {.x = symmetries[s][bitboard->x],
+                                  .o = symmetries[s][bitboard->o]};
+    if (mapped.o < canonical->o ||
+        (mapped.o == canonical->o && mapped.x < canonical->x)) {
+      bestSymmetry = s;
+      *canonical = mapped;
+    }
+  }
+#endif
+  return bestSymmetry;
+}
+
+// Return the board location of the single square set in the mask.
+tictactoe_location_t
+ticTacToeBitboard_toLocation(ticTacToeBitboard_mask_t square) {
+  uint8_t index = __builtin_ctzll(square);
+  tictactoe_location_t location = {.row = index / TICTACTOE_BOARD_COLUMNS,
+                                   .column = index % TICTACTOE_BOARD_COLUMNS};
+  return location;
+}
@@ -0,0 +1,127 @@
+#ifndef TICTACTOEBITBOARD
+#define TICTACTOEBITBOARD
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "minimax.h"
+#include "ticTacToe.h"
+
+// A bitboard keeps one bit per square for each player. Square (row, column)
+// is bit row * TICTACTOE_BOARD_COLUMNS + column.
+#define TICTACTOEBITBOARD_SQUARES                                              \
+  (TICTACTOE_BOARD_ROWS * TICTACTOE_BOARD_COLUMNS)
+
+#if TICTACTOEBITBOARD_SQUARES <= 16
+typedef uint16_t ticTacToeBitboard_mask_t;
+#elif TICTACTOEBITBOARD_SQUARES <= 32
+typedef uint32_t ticTacToeBitboard_mask_t;
+#else
+typedef uint64_t ticTacToeBitboard_mask_t;
+#endif
+
+#define TICTACTOEBITBOARD_BIT(index) ((ticTacToeBitboard_mask_t)1 << (index))
+#define TICTACTOEBITBOARD_ALL_SQUARES                                          \
+  ((ticTacToeBitboard_mask_t)(((uint64_t)1 << TICTACTOEBITBOARD_SQUARES) - 1))
+#define TICTACTOEBITBOARD_SQUARE(row, column)                                  \
+  TICTACTOEBITBOARD_BIT((row) * TICTACTOE_BOARD_COLUMNS + (column))
+
+// Number of winning lines: TICTACTOE_WIN_LENGTH squares in a row, column or
+// diagonal
+#define TICTACTOEBITBOARD_LINE_STARTS(length)                                  \
+  ((length) - TICTACTOE_WIN_LENGTH + 1)
+#define TICTACTOEBITBOARD_WIN_LINES                                            \
+  (TICTACTOE_BOARD_ROWS *                                                      \
+       TICTACTOEBITBOARD_LINE_STARTS(TICTACTOE_BOARD_COLUMNS) +                \
+   TICTACTOE_BOARD_COLUMNS *                                                   \
+       TICTACTOEBITBOARD_LINE_STARTS(TICTACTOE_BOARD_ROWS) +                   \
+   2 * TICTACTOEBITBOARD_LINE_STARTS(TICTACTOE_BOARD_ROWS) *                   \
+       TICTACTOEBITBOARD_LINE_STARTS(TICTACTOE_BOARD_COLUMNS))
+
+// Most winning lines through one square: four directions, and each line
+// containing the square can start at TICTACTOE_WIN_LENGTH places
+#define TICTACTOEBITBOARD_MAX_LINES_PER_SQUARE (4 * TICTACTOE_WIN_LENGTH)
+
+// Rotations and reflections of the board that positions are merged under.
+// Symmetries are applied through a lookup table with one entry per mask, so
+// they are only used on small square boards (3x3 and below).
+#if TICTACTOE_BOARD_ROWS == TICTACTOE_BOARD_COLUMNS &&                        \
+    TICTACTOEBITBOARD_SQUARES <= 9
+#define TICTACTOEBITBOARD_SYMMETRIES 8
+#else
+#define TICTACTOEBITBOARD_SYMMETRIES 1
+#endif
+
+// Lowest set square in a mask, and the mask with that square cleared. Used to
+// walk the empty squares of a board without looking at occupied ones.
+#define TICTACTOEBITBOARD_LOWEST_SQUARE(mask) ((mask) & (~(mask) + 1))
+#define TICTACTOEBITBOARD_CLEAR_LOWEST(mask) ((mask) & ((mask)-1))
+
+typedef struct {
+  ticTacToeBitboard_mask_t x; // Squares occupied by X
+  ticTacToeBitboard_mask_t o; // Squares occupied by O
+} ticTacToeBitboard_t;
+
+// Convert an array board into a bitboard.
+void ticTacToeBitboard_fromBoard(tictactoe_board_t *board,
+                                 ticTacToeBitboard_t *bitboard);
+
+// Convert a bitboard into an array board.
+void ticTacToeBitboard_toBoard(ticTacToeBitboard_t *bitboard,
+                               tictactoe_board_t *board);
+
+// Return the number of squares set in a mask.
+uint8_t ticTacToeBitboard_count(ticTacToeBitboard_mask_t mask);
+
+// Return true if the squares contain a full winning line.
+bool ticTacToeBitboard_isWin(ticTacToeBitboard_mask_t squares);
+
+// Return true if the squares contain a full winning line through the given
+// square (bit index). Only the lines through that square are checked, so this
+// is the cheap test after a move.
+bool ticTacToeBitboard_isWinThrough(ticTacToeBitboard_mask_t squares,
+                                    uint8_t square);
+
+// Return the empty squares that would complete a winning line for the player
+// with the squares in mine (the opponent has theirs).
+ticTacToeBitboard_mask_t
+ticTacToeBitboard_getWinningSquares(ticTacToeBitboard_mask_t mine,
+                                    ticTacToeBitboard_mask_t theirs);
+
+// Bitboard version of minimax_computeBoardScore(), with the same arguments and
+// return values.
+minimax_score_t ticTacToeBitboard_computeScore(ticTacToeBitboard_t *bitboard,
+                                               bool is_Xs_turn);
+
+// Heuristic value of a position for X: every line still open to only one
+// player counts the square of its number of pieces, positive for X and
+// negative for O.
+int16_t ticTacToeBitboard_evaluate(ticTacToeBitboard_t *bitboard);
+
+// Return the squares (bit indexes) ordered by the number of winning lines
+// through them, most first (center, then corners, then edges on 3x3).
+const uint8_t *ticTacToeBitboard_getMoveOrder();
+
+// Pack a bitboard of up to 16 squares into a single number: the X mask in the
+// low bits and the O mask above it.
+uint32_t ticTacToeBitboard_toKey(ticTacToeBitboard_t *bitboard);
+
+// Apply one of the board's symmetries (0 to TICTACTOEBITBOARD_SYMMETRIES - 1)
+// to a mask. Symmetry 0 leaves the board unchanged.
+ticTacToeBitboard_mask_t
+ticTacToeBitboard_transform(ticTacToeBitboard_mask_t mask, uint8_t symmetry);
+
+// Return the symmetry that undoes the given one.
+uint8_t ticTacToeBitboard_inverseSymmetry(uint8_t symmetry);
+
+// Find the canonical form of the board: the one of its symmetric forms with
+// the smallest masks. The canonical board is written to canonical, and the
+// symmetry that maps the board onto it is returned.
+uint8_t ticTacToeBitboard_canonicalize(ticTacToeBitboard_t *bitboard,
+                                       ticTacToeBitboard_t *canonical);
+
+// Return the board location of the single square set in the mask.
+tictactoe_location_t
+ticTacToeBitboard_toLocation(ticTacToeBitboard_mask_t square);
+
+#endif /* TICTACTOEBITBOARD */
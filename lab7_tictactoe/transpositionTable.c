@@ -0,0 +1,76 @@
+#include <string.h>
+
+#include "transpositionTable.h"
+
+// Fields of a packed entry
+#define SCORE_SHIFT 0
+#define BOUND_SHIFT 16
+#define DEPTH_SHIFT 24
+#define SQUARE_SHIFT 32
+#define FIELD_MASK 0xFF
+
+#define GOLDEN_RATIO_64 0x9E3779B97F4A7C15ull
+
+typedef struct {
+  volatile uint64_t check; // key ^ data
+  volatile uint64_t data;  // Packed transpositionTable_entry_t
+} slot_t;
+
+static slot_t table[TRANSPOSITIONTABLE_SIZE];
+
+/***********HELPER FUNCTIONS************/
+
+// Return the key of a position
+static uint64_t getKey(ticTacToeBitboard_t *board) {
+#if TICTACTOEBITBOARD_SQUARES <= 32
+  return board->x | ((uint64_t)board->o << 32);
+#else
+  uint64_t key = board->x * GOLDEN_RATIO_64;
+  return (key ^ (key >> 29) ^ board->o) * GOLDEN_RATIO_64;
+#endif
+}
+
+// Return the slot for a key (Fibonacci hashing spreads the masks)
+static slot_t *getSlot(uint64_t key) {
+  return &table[(key * GOLDEN_RATIO_64) >> (64 - TRANSPOSITIONTABLE_BITS)];
+}
+
+/***********HEADER FUNCTIONS************/
+
+// Remove every entry.
+void transpositionTable_clear() { memset(table, 0, sizeof(table)); }
+
+// Look up a position.
+bool transpositionTable_probe(ticTacToeBitboard_t *board,
+                              transpositionTable_entry_t *entry) {
+  uint64_t key = getKey(board);
+  slot_t *slot = getSlot(key);
+
+  // Read each word once; a slot being written by another core fails the check
+  uint64_t data = slot->data;
+  uint64_t check = slot->check;
+  uint8_t bound = (data >> BOUND_SHIFT) & FIELD_MASK;
+  if (bound == TRANSPOSITIONTABLE_EMPTY || (check ^ data) != key)
+    return false;
+
+  entry->score = (minimax_score_t)(data >> SCORE_SHIFT);
+  entry->bound = bound;
+  entry->depth = (data >> DEPTH_SHIFT) & FIELD_MASK;
+  entry->bestSquare = (data >> SQUARE_SHIFT) & FIELD_MASK;
+  return true;
+}
+
+// Store the score of a position.
+void transpositionTable_store(ticTacToeBitboard_t *board, minimax_score_t score,
+                              transpositionTable_bound_t bound, uint8_t depth,
+                              uint8_t bestSquare) {
+  uint64_t key = getKey(board);
+  slot_t *slot = getSlot(key);
+
+  uint64_t data = ((uint64_t)(uint16_t)score << SCORE_SHIFT) |
+                  ((uint64_t)bound << BOUND_SHIFT) |
+                  ((uint64_t)depth << DEPTH_SHIFT) |
+                  ((uint64_t)bestSquare << SQUARE_SHIFT);
+  slot->check = key ^ data;
+  slot->data = data;
+}
@@ -0,0 +1,65 @@
+#ifndef TRANSPOSITIONTABLE
+#define TRANSPOSITIONTABLE
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "minimax.h"
+#include "ticTacToeBitboard.h"
+
+// Number of entries (a power of two). A 3x3 board has fewer than 800 positions
+// once rotations and reflections are merged; larger boards are only searched a
+// few plies deep, but the trees are much wider.
+#if TICTACTOEBITBOARD_SQUARES <= 9
+#define TRANSPOSITIONTABLE_BITS 11
+#else
+#define TRANSPOSITIONTABLE_BITS 16
+#endif
+#define TRANSPOSITIONTABLE_SIZE (1u << TRANSPOSITIONTABLE_BITS)
+
+// Stored in bestSquare when no move is known
+#define TRANSPOSITIONTABLE_NO_SQUARE 0xFF
+
+// What a stored score says about the position's true score. Alpha-beta only
+// finds the exact score of positions whose score falls inside the search
+// window; the others are only known to be at least or at most the score.
+typedef enum {
+  TRANSPOSITIONTABLE_EMPTY, // Unused entry
+  TRANSPOSITIONTABLE_EXACT, // Score is exact
+  TRANSPOSITIONTABLE_LOWER, // True score >= score
+  TRANSPOSITIONTABLE_UPPER  // True score <= score
+} transpositionTable_bound_t;
+
+typedef struct {
+  minimax_score_t score; // Score found for the position
+  uint8_t bound;         // A transpositionTable_bound_t
+  uint8_t depth;         // Plies searched below the position
+  uint8_t bestSquare;    // Best move found (bit index)
+} transpositionTable_entry_t;
+
+// Cache of searched positions, so a position reached through different move
+// orders (or as a rotation or reflection of one already searched) is only
+// searched once. Positions are stored in canonical form (see
+// ticTacToeBitboard_canonicalize()). When two positions share a slot the
+// newest one wins.
+//
+// The table is shared by the cores of a parallel search without any locks.
+// Each slot holds the entry packed into one word, and a check word that is the
+// position's key XORed with it. An entry torn by two cores writing the slot at
+// once fails the check, and reads as a miss. Keys are exact for boards of up
+// to 32 squares, and a 64-bit hash of the position above that.
+
+// Remove every entry. No search may be running.
+void transpositionTable_clear();
+
+// Look up a position. Returns true and copies the entry if it is stored.
+bool transpositionTable_probe(ticTacToeBitboard_t *board,
+                              transpositionTable_entry_t *entry);
+
+// Store the score of a position searched depth plies deep, and its best move,
+// replacing whatever was in its slot.
+void transpositionTable_store(ticTacToeBitboard_t *board, minimax_score_t score,
+                              transpositionTable_bound_t bound, uint8_t depth,
+                              uint8_t bestSquare);
+
+#endif /* TRANSPOSITIONTABLE */
@@ -0,0 +1,66 @@
+#include "collisionGrid.h"
+
+// Marks the end of a cell's list
+#define NO_ITEM -1
+
+// First item in each cell, and the next item in the same cell for each item
+static int16_t cellHead[COLLISIONGRID_ROWS][COLLISIONGRID_COLUMNS];
+static int16_t nextItem[COLLISIONGRID_MAX_ITEMS];
+
+////////// Helper Functions //////////
+
+// Return the column of the cell containing x, clamped to the grid.
+static int16_t getColumn(int16_t x) {
+  if (x < 0)
+    return 0;
+  if (x >= DISPLAY_WIDTH)
+    return COLLISIONGRID_COLUMNS - 1;
+  return x / COLLISIONGRID_CELL_SIZE;
+}
+
+// Return the row of the cell containing y, clamped to the grid.
+static int16_t getRow(int16_t y) {
+  if (y < 0)
+    return 0;
+  if (y >= DISPLAY_HEIGHT)
+    return COLLISIONGRID_ROWS - 1;
+  return y / COLLISIONGRID_CELL_SIZE;
+}
+
+////////// Header Functions //////////
+
+// Remove every item from the grid.
+void collisionGrid_clear() {
+  for (uint16_t row = 0; row < COLLISIONGRID_ROWS; row++)
+    for (uint16_t column = 0; column < COLLISIONGRID_COLUMNS; column++)
+      cellHead[row][column] = NO_ITEM;
+}
+
+// Add the item with the given id at (x, y).
+void collisionGrid_insert(uint16_t id, int16_t x, int16_t y) {
+  int16_t *head = &cellHead[getRow(y)][getColumn(x)];
+
+  // Push onto the front of the cell's list
+  nextItem[id] = *head;
+  *head = id;
+}
+
+// Find the items in every cell overlapping the square around (x, y).
+uint16_t collisionGrid_query(int16_t x, int16_t y, int16_t radius,
+                             uint16_t ids[], uint16_t maxIds) {
+  uint16_t found = 0;
+
+  for (int16_t row = getRow(y - radius); row <= getRow(y + radius); row++) {
+    for (int16_t column = getColumn(x - radius);
+         column <= getColumn(x + radius); column++) {
+      // Walk the cell's list
+      for (int16_t id = cellHead[row][column]; id != NO_ITEM;
+           id = nextItem[id]) {
+        if (found == maxIds)
+          return found;
+        ids[found++] = id;
+      }
+    }
+  }
+  return found;
+}
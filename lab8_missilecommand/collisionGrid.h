@@ -0,0 +1,40 @@
+#ifndef COLLISIONGRID
+#define COLLISIONGRID
+
+#include <stdint.h>
+
+#include "config.h"
+#include "display.h"
+
+// The play field is split into square cells of this size (in pixels). Cells
+// are a little larger than the biggest explosion, so a query touches at most
+// a 3x3 block of cells.
+#define COLLISIONGRID_CELL_SIZE 32
+#define COLLISIONGRID_COLUMNS                                                  \
+  ((DISPLAY_WIDTH + COLLISIONGRID_CELL_SIZE - 1) / COLLISIONGRID_CELL_SIZE)
+#define COLLISIONGRID_ROWS                                                     \
+  ((DISPLAY_HEIGHT + COLLISIONGRID_CELL_SIZE - 1) / COLLISIONGRID_CELL_SIZE)
+
+// Most items the grid can hold, one per missile.
+#define COLLISIONGRID_MAX_ITEMS CONFIG_MAX_TOTAL_MISSILES
+
+// Uniform grid over the play field used to find the missiles near an
+// explosion without checking every missile. Items are identified by an id
+// (the missile's index), and each cell keeps a linked list of the items
+// inside it. The grid is cleared and rebuilt once per tick.
+
+// Remove every item from the grid.
+void collisionGrid_clear();
+
+// Add the item with the given id at (x, y). Points off the play field are
+// placed in the nearest edge cell. Each id may only be inserted once between
+// clears.
+void collisionGrid_insert(uint16_t id, int16_t x, int16_t y);
+
+// Find the items in every cell overlapping the square that bounds the circle
+// of the given radius around (x, y). Up to maxIds ids are written to ids and
+// the number found is returned. The items still need an exact distance check.
+uint16_t collisionGrid_query(int16_t x, int16_t y, int16_t radius,
+                             uint16_t ids[], uint16_t maxIds);
+
+#endif /* COLLISIONGRID */
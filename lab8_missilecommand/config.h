@@ -4,8 +4,19 @@
 #define CONFIG_TOUCHSCREEN_TIMER_PERIOD 10.0E-3
 #define CONFIG_GAME_TIMER_PERIOD 45.0E-3
 
+// Resolution of the timer wheel that runs both of the timers above off one
+// interval timer. Both periods are whole multiples of it.
+#define CONFIG_TIMER_WHEEL_TICK_PERIOD 5.0E-3
+
+// Stress mode (build with CONFIG_STRESS_MODE defined) fills the sky with
+// missiles, fires player missiles automatically and reports tick times.
+#ifdef CONFIG_STRESS_MODE
+#define CONFIG_MAX_ENEMY_MISSILES 300
+#define CONFIG_MAX_PLAYER_MISSILES 40
+#else
 #define CONFIG_MAX_ENEMY_MISSILES 7
 #define CONFIG_MAX_PLAYER_MISSILES 4
+#endif
 #define CONFIG_MAX_PLANE_MISSILES 1
 #define CONFIG_MAX_TOTAL_MISSILES                                              \
   (CONFIG_MAX_ENEMY_MISSILES + CONFIG_MAX_PLAYER_MISSILES +                    \
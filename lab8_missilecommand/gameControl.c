@@ -1,16 +1,19 @@
 #include "gameControl.h"
+#include "collisionGrid.h"
 #include "config.h"
+#include "gameRandom.h"
 #include "missile.h"
+#include "missilePool.h"
 #include "plane.h"
 
+#include "displayLine.h"
+#include "textField.h"
 #include "touchscreen.h"
 
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
-
-// Index of the first missile in the second half of the missiles array
-#define MISSILES_HALFWAY_INDEX (CONFIG_MAX_TOTAL_MISSILES / 2)
+#include <stdlib.h>
 
 // Define array for all missiles and sub-arrays for different types
 static missile_t missiles[CONFIG_MAX_TOTAL_MISSILES];
@@ -19,27 +22,37 @@ static missile_t *player_missiles = &(missiles[CONFIG_MAX_ENEMY_MISSILES]);
 static missile_t *plane_missile = &(missiles[CONFIG_MAX_TOTAL_MISSILES - 1]);
 
 // Keep track of statistics
-static uint8_t player_shots;
-static uint8_t enemy_impacts;
-static uint8_t prev_player_shots;
-static uint8_t prev_enemy_impacts;
+static uint16_t player_shots;
+static uint16_t enemy_impacts;
+static uint32_t game_ticks;
+static uint32_t enemy_launches;
+static uint32_t interceptions;
+static bool statsChanged; // Statistics need to be re-printed
 
 // Other global variables
 static display_point_t touchedLocation; // Most recent touched location
-static bool tickFirstHalf; // Flag telling to tick even or odd missiles
-static bool firstTick;
+
+// On-screen statistics readouts
+static textField_t shotsField;
+static textField_t impactsField;
+
+// Missiles found near an explosion by the collision grid
+static uint16_t nearbyMissiles[COLLISIONGRID_MAX_ITEMS];
 
 // Checks if the given point is within the exploding radius of the
 // given exploding missile
 static bool point_isInExplosion(uint16_t pX, uint16_t pY,
                                 missile_t *expMissile) {
-  // Calculate distance (squared) from the exploding missile
-  int16_t delta_x = pX - expMissile->x_current;
-  int16_t delta_y = pY - expMissile->y_current;
-  float distFromExplosionSqr = (float)(delta_x * delta_x + delta_y * delta_y);
+  // Calculate distance (squared) from the exploding missile, in Q32.32 fixed
+  // point to match the square of the Q16.16 radius
+  int32_t delta_x = pX - expMissile->x_current;
+  int32_t delta_y = pY - expMissile->y_current;
+  int64_t distFromExplosionSqr =
+      (int64_t)(delta_x * delta_x + delta_y * delta_y)
+      << (2 * MISSILEPOOL_FIXED_SHIFT);
 
   // Get square of the explosion radius
-  float radiusSqr = expMissile->radius * expMissile->radius;
+  int64_t radiusSqr = (int64_t)expMissile->radius * expMissile->radius;
 
   // If missile is within explosion radius and is flying, trigger
   // explosion
@@ -49,6 +62,38 @@ static bool point_isInExplosion(uint16_t pX, uint16_t pY,
     return false;
 }
 
+// Launches the first dead player missile found towards (x, y)
+static void firePlayerMissile(uint16_t x, uint16_t y) {
+  // Iterate through player missiles
+  for (uint16_t i = 0; i < CONFIG_MAX_PLAYER_MISSILES; i++) {
+    // Re-initialize the first dead player missile found
+    if (missile_is_dead(&player_missiles[i])) {
+      missile_init_player(&player_missiles[i], x, y);
+      player_shots++;
+      statsChanged = true;
+      break;
+    }
+  }
+}
+
+// Puts every missile that an explosion can blow up into the collision grid,
+// using its index in the missiles array as its id
+static void buildCollisionGrid() {
+  collisionGrid_clear();
+
+  // Flying enemy missiles
+  for (uint16_t i = 0; i < CONFIG_MAX_ENEMY_MISSILES; i++) {
+    if (missile_is_flying(&enemy_missiles[i]))
+      collisionGrid_insert(i, enemy_missiles[i].x_current,
+                           enemy_missiles[i].y_current);
+  }
+
+  // The plane's missile
+  if (missile_is_flying(plane_missile))
+    collisionGrid_insert(CONFIG_MAX_TOTAL_MISSILES - 1,
+                         plane_missile->x_current, plane_missile->y_current);
+}
+
 #define SHOTS_CURSOR_X 10
 #define SHOTS_CURSOR_Y 10
 #define IMPACTS_CURSOR_X (DISPLAY_WIDTH / 2)
@@ -56,40 +101,21 @@ static bool point_isInExplosion(uint16_t pX, uint16_t pY,
 #define STATISTICS_TEXT_SIZE 1
 #define MAX_STR_LEN 15
 
-// Erases and re-prints the statistics at the top of the screen
+// Re-prints the statistics at the top of the screen. The text fields only
+// redraw the digits that changed, so no erase pass is needed.
 void printStatistics() {
   char shotsStr[MAX_STR_LEN];
   char impactsStr[MAX_STR_LEN];
 
-  // ERASE TEXT FROM PREVIOUS TICK //
-
-  // Populate strings with the text to be printed
-  sprintf(shotsStr, "Shots: %d", prev_player_shots);
-  sprintf(impactsStr, "Impacts: %d", prev_enemy_impacts);
-
-  // Print the number of shots the player has fired
-  display_setTextColor(DISPLAY_BLACK);
-  display_setCursor(SHOTS_CURSOR_X, SHOTS_CURSOR_Y);
-  display_print(shotsStr);
-
-  // Print the number of impacted enemy/plane missiles
-  display_setCursor(IMPACTS_CURSOR_X, IMPACTS_CURSOR_Y);
-  display_print(impactsStr);
-
-  // PRINT NEW TEXT WITH UPDATED STATISTICS //
-
   // Populate strings with the text to be printed
   sprintf(shotsStr, "Shots: %d", player_shots);
   sprintf(impactsStr, "Impacts: %d", enemy_impacts);
 
   // Print the number of shots the player has fired
-  display_setTextColor(DISPLAY_WHITE);
-  display_setCursor(SHOTS_CURSOR_X, SHOTS_CURSOR_Y);
-  display_print(shotsStr);
+  textField_draw(&shotsField, shotsStr);
 
   // Print the number of impacted enemy/plane missiles
-  display_setCursor(IMPACTS_CURSOR_X, IMPACTS_CURSOR_Y);
-  display_print(impactsStr);
+  textField_draw(&impactsField, impactsStr);
 }
 
 // Initialize the game control logic
@@ -105,30 +131,33 @@ void gameControl_init() {
   // Initialize the plane
   plane_init(plane_missile);
 
+  // Initialize the statistics readouts
+  textField_init(&shotsField, SHOTS_CURSOR_X, SHOTS_CURSOR_Y,
+                 STATISTICS_TEXT_SIZE, DISPLAY_WHITE, DISPLAY_BLACK);
+  textField_init(&impactsField, IMPACTS_CURSOR_X, IMPACTS_CURSOR_Y,
+                 STATISTICS_TEXT_SIZE, DISPLAY_WHITE, DISPLAY_BLACK);
+
   // Initialize other global variables
   touchedLocation.x = touchedLocation.y = 0;
-  tickFirstHalf = true;
-  firstTick = true;
   player_shots = 0;
   enemy_impacts = 0;
-  prev_player_shots = 0;
-  prev_enemy_impacts = 0;
+  game_ticks = 0;
+  enemy_launches = 0;
+  interceptions = 0;
+  statsChanged = true;
 }
 
-// Tick the game control logic
+// Advance the game by one tick without drawing anything
 //
-// This function should tick the missiles, handle screen touches, collisions,
-// and updating statistics.
-void gameControl_tick() {
-  // Keep track of statistics from previous tick
-  prev_player_shots = player_shots;
-  prev_enemy_impacts = enemy_impacts;
-
+// This function updates the missiles and plane, handles screen touches,
+// collisions, and updates statistics.
+void gameControl_update() {
   // Iterate through all enemy missiles
   for (uint16_t i = 0; i < CONFIG_MAX_ENEMY_MISSILES; i++) {
     // Re-initialize any dead enemy missiles
     if (missile_is_dead(&enemy_missiles[i])) {
       missile_init_enemy(&enemy_missiles[i]);
+      enemy_launches++;
     }
   }
 
@@ -137,27 +166,30 @@ void gameControl_tick() {
   //   touchedLocation = touchscreen_get_location();
   // }
 
-  // Re-initialize one dead player missile if the screen is released
-  if (touchscreen_get_status() == TOUCHSCREEN_RELEASED) {
-    touchedLocation = touchscreen_get_location();
-    touchscreen_ack_touch();
-
-    // Iterate through player missiles
-    for (uint16_t i = 0; i < CONFIG_MAX_PLAYER_MISSILES; i++) {
-      // Re-initialize the first dead player missile found
-      if (missile_is_dead(&player_missiles[i])) {
-        missile_init_player(&player_missiles[i], touchedLocation.x,
-                            touchedLocation.y);
-        player_shots++;
-        break;
-      }
-    }
+  // Re-initialize a dead player missile for every release of the screen
+  // since the last update
+  touchscreen_event_t event;
+  while (touchscreen_getEvent(&event)) {
+    if (event.type != TOUCHSCREEN_EVENT_RELEASE)
+      continue;
+    touchedLocation = event.location;
+    firePlayerMissile(touchedLocation.x, touchedLocation.y);
   }
 
+#ifdef CONFIG_STRESS_MODE
+  // Keep the sky full of explosions without anyone touching the screen
+  firePlayerMissile(gameRandom_next(DISPLAY_WIDTH),
+                    gameRandom_next(DISPLAY_HEIGHT));
+#endif
+
   missile_t *explodingMissile = NULL;
   missile_t *currMissile = NULL;
   bool missile_isInExplosion;
 
+  // Bucket the missiles that can be blown up, so each explosion only checks
+  // the missiles near it
+  buildCollisionGrid();
+
   // Iterate through all exploding missiles to check if other missiles
   // explosions' must be triggered
   for (uint16_t i = 0; i < CONFIG_MAX_TOTAL_MISSILES; i++) {
@@ -165,27 +197,28 @@ void gameControl_tick() {
     if (missile_is_exploding(&missiles[i])) {
       explodingMissile = &missiles[i];
 
-      // Iterate through all enemy missiles
-      for (uint16_t j = 0; j < CONFIG_MAX_ENEMY_MISSILES; j++) {
-        currMissile = &enemy_missiles[j];
+      // Find the enemy and plane missiles near the explosion
+      uint16_t nearbyCount = collisionGrid_query(
+          explodingMissile->x_current, explodingMissile->y_current,
+          MISSILEPOOL_FROM_FIXED(explodingMissile->radius) + 1, nearbyMissiles,
+          COLLISIONGRID_MAX_ITEMS);
+
+      // Iterate through the nearby missiles
+      for (uint16_t j = 0; j < nearbyCount; j++) {
+        currMissile = &missiles[nearbyMissiles[j]];
         missile_isInExplosion = point_isInExplosion(
             currMissile->x_current, currMissile->y_current, explodingMissile);
 
         // Check if the missile is within the explosion radius of the exploding
-        // missile
-        if (missile_isInExplosion && missile_is_flying(currMissile)) {
+        // missile. A missile already triggered by another explosion this tick
+        // is still flying until it updates, so it isn't counted again.
+        if (missile_isInExplosion && missile_is_flying(currMissile) &&
+            !currMissile->explode_me) {
           missile_trigger_explosion(currMissile);
+          interceptions++;
         }
       }
 
-      missile_isInExplosion = point_isInExplosion(
-          plane_missile->x_current, plane_missile->y_current, explodingMissile);
-
-      // Check the plane missile
-      if (missile_isInExplosion && missile_is_flying(plane_missile)) {
-        missile_trigger_explosion(plane_missile);
-      }
-
       display_point_t plane_loc = plane_getXY();
       bool plane_isInExplosion =
           point_isInExplosion(plane_loc.x, plane_loc.y, explodingMissile);
@@ -197,46 +230,69 @@ void gameControl_tick() {
     }
   }
 
-  // Tick half of the missiles (either first or last half)
-  if (tickFirstHalf) {
-    // Tick the first half of the missiles array
-    for (uint16_t i = 0; i < MISSILES_HALFWAY_INDEX; i++) {
-      missile_tick(&missiles[i]);
-    }
-  } else {
-    // Tick the last half of the missiles array
-    for (uint16_t i = MISSILES_HALFWAY_INDEX; i < CONFIG_MAX_TOTAL_MISSILES;
-         i++) {
-      missile_tick(&missiles[i]);
-    }
-  }
-
-  // Tick other half of the missiles next cycle
-  tickFirstHalf = !tickFirstHalf;
+  // Update all of the missiles in one batch
+  missile_updateAll(missiles, CONFIG_MAX_TOTAL_MISSILES);
 
-  // Tick the plane
-  plane_tick();
+  // Update the plane
+  plane_update();
 
   // Check for any impacted enemy missiles
   for (uint16_t i = 0; i < CONFIG_MAX_ENEMY_MISSILES; i++) {
     currMissile = &enemy_missiles[i];
     if (currMissile->impacted) {
       enemy_impacts++;
+      statsChanged = true;
     }
   }
 
   // Check for an impacted plane missile
   if (plane_missile->impacted) {
     enemy_impacts++;
+    statsChanged = true;
     // Don't want to read that it is impacted next tick
     plane_missile->impacted = false;
   }
 
+  game_ticks++;
+}
+
+// Draw the difference between the screen and the current game state
+void gameControl_render() {
+  // Queue trail updates so they go out as sorted, merged line writes
+  displayLine_batchBegin();
+
+  // Render all of the missiles
+  for (uint16_t i = 0; i < CONFIG_MAX_TOTAL_MISSILES; i++) {
+    missile_render(&missiles[i]);
+  }
+
+  // Draw all of the queued trail updates
+  displayLine_batchEnd();
+
+  // Render the plane
+  plane_render();
+
   // If statistics have changed, update the printed statistics
-  if (prev_enemy_impacts != enemy_impacts ||
-      prev_player_shots != player_shots || firstTick) {
+  if (statsChanged) {
     printStatistics();
+    statsChanged = false;
   }
+}
 
-  firstTick = false;
+// Copy the statistics of the current game into stats
+void gameControl_getStats(gameControl_stats_t *stats) {
+  stats->ticks = game_ticks;
+  stats->enemyLaunches = enemy_launches;
+  stats->interceptions = interceptions;
+  stats->playerShots = player_shots;
+  stats->impacts = enemy_impacts;
+}
+
+// Tick the game control logic
+//
+// This function should tick the missiles, handle screen touches, collisions,
+// and updating statistics.
+void gameControl_tick() {
+  gameControl_update();
+  gameControl_render();
 }
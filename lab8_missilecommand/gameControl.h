@@ -2,6 +2,16 @@
 #define GAMECONTROL
 
 #include <stdbool.h>
+#include <stdint.h>
+
+// Running totals for the current game, see gameControl_getStats()
+typedef struct {
+  uint32_t ticks;         // Game ticks since gameControl_init()
+  uint32_t enemyLaunches; // Enemy missiles launched
+  uint32_t interceptions; // Enemy and plane missiles blown up by explosions
+  uint16_t playerShots;   // Player missiles fired
+  uint16_t impacts;       // Enemy and plane missiles that reached the ground
+} gameControl_stats_t;
 
 // Initialize the game control logic
 // This function will initialize all missiles, stats, plane, etc.
@@ -13,4 +23,15 @@ void gameControl_init();
 // and updating statistics.
 void gameControl_tick();
 
+// Advance the game by one tick without drawing anything. Call this once for
+// every game timer tick.
+void gameControl_update();
+
+// Draw the difference between the screen and the current game state. Any
+// number of updates can be rendered by a single call.
+void gameControl_render();
+
+// Copy the statistics of the current game into stats.
+void gameControl_getStats(gameControl_stats_t *stats);
+
 #endif /* GAMECONTROL */
@@ -0,0 +1,19 @@
+#include "gameRandom.h"
+
+static uint32_t state = GAMERANDOM_DEFAULT_SEED;
+
+////////// Header Functions //////////
+
+// Restart the sequence from the given seed.
+void gameRandom_seed(uint32_t seed) {
+  state = seed ? seed : GAMERANDOM_DEFAULT_SEED;
+}
+
+// Return the next random number in [0, bound).
+uint32_t gameRandom_next(uint32_t bound) {
+  // xorshift32 (Marsaglia)
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state % bound;
+}
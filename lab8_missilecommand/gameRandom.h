@@ -0,0 +1,20 @@
+#ifndef GAMERANDOM
+#define GAMERANDOM
+
+#include <stdint.h>
+
+// Seed used until gameRandom_seed() is called
+#define GAMERANDOM_DEFAULT_SEED 0x2545F491
+
+// Random number generator shared by the missiles and plane (xorshift32). The
+// game doesn't use rand(), so seeding this before gameControl_init() makes a
+// whole game, including the enemy missiles and plane, repeat exactly.
+
+// Restart the sequence from the given seed. A seed of 0 is replaced by the
+// default seed, since xorshift can't leave the all-zero state.
+void gameRandom_seed(uint32_t seed);
+
+// Return the next random number in [0, bound). bound must not be 0.
+uint32_t gameRandom_next(uint32_t bound);
+
+#endif /* GAMERANDOM */
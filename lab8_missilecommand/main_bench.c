@@ -0,0 +1,83 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "config.h"
+#include "gameRandom.h"
+#include "intervalTimer.h"
+#include "missile.h"
+
+// Number of enemy missiles flying at once during the benchmark
+#define BENCH_MISSILES 4000
+
+// Number of game ticks simulated for each update method
+#define BENCH_TICKS 200
+
+// Timer used as a stopwatch
+#define BENCH_TIMER INTERVAL_TIMER_0
+
+static missile_t *missiles;
+
+// Relaunch every enemy missile that has died so the pool stays full
+static void relaunchDead() {
+  for (uint16_t i = 0; i < BENCH_MISSILES; i++)
+    if (missile_is_dead(&missiles[i]))
+      missile_init_enemy(&missiles[i]);
+}
+
+// Run the simulation for BENCH_TICKS ticks and return the time spent updating
+// missiles, in seconds. Either every missile is updated on its own, or the
+// whole array is updated in one batch.
+static double runBench(bool batched) {
+  double updateSeconds = 0.0;
+
+  gameRandom_seed(0);
+  for (uint16_t i = 0; i < BENCH_MISSILES; i++)
+    missile_init_enemy(&missiles[i]);
+
+  for (uint16_t tick = 0; tick < BENCH_TICKS; tick++) {
+    intervalTimer_reload(BENCH_TIMER);
+    intervalTimer_start(BENCH_TIMER);
+    if (batched) {
+      missile_updateAll(missiles, BENCH_MISSILES);
+    } else {
+      for (uint16_t i = 0; i < BENCH_MISSILES; i++)
+        missile_update(&missiles[i]);
+    }
+    intervalTimer_stop(BENCH_TIMER);
+    updateSeconds += intervalTimer_getTotalDurationInSeconds(BENCH_TIMER);
+
+    // Relaunching isn't part of the update cost
+    relaunchDead();
+  }
+  return updateSeconds;
+}
+
+// Print the update rate of one method
+static void printResult(const char *name, double seconds) {
+  double updates = (double)BENCH_MISSILES * BENCH_TICKS;
+  printf("%-12s %8.3f ms total, %10.0f missile updates/s\n", name,
+         seconds * 1000.0, updates / seconds);
+}
+
+// Measure the missile update rate with a pool much larger than a normal game,
+// comparing per-missile updates against the batched structure-of-arrays pass.
+int main() {
+  printf("Missile update benchmark: %d missiles, %d ticks\n", BENCH_MISSILES,
+         BENCH_TICKS);
+
+  missiles = malloc(BENCH_MISSILES * sizeof(missile_t));
+  assert(missiles != NULL);
+  missile_initPool(BENCH_MISSILES);
+  for (uint16_t i = 0; i < BENCH_MISSILES; i++)
+    missile_init_dead(&missiles[i]);
+
+  intervalTimer_initCountUp(BENCH_TIMER);
+
+  printResult("per-missile", runBench(false));
+  printResult("batched", runBench(true));
+
+  free(missiles);
+  return 0;
+}
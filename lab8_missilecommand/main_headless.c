@@ -0,0 +1,126 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "config.h"
+#include "display.h"
+#include "gameControl.h"
+#include "gameRandom.h"
+#include "headless.h"
+
+// Defaults, each can be overridden on the command line:
+//   lab8_headless.elf [games] [ticks per game] [seed] [render]
+// Rendering to the null display can be turned off (render = 0) to time only
+// the game logic.
+#define DEFAULT_GAMES 1000
+#define DEFAULT_TICKS_PER_GAME ((uint32_t)(60 / CONFIG_GAME_TIMER_PERIOD))
+#define DEFAULT_SEED 1
+#define DEFAULT_RENDER 1
+
+// The scripted player taps a random spot in the lower two thirds of the screen
+// this often
+#define TOUCH_INTERVAL_TICKS 8
+#define TOUCH_TOP_Y (DISPLAY_HEIGHT / 3)
+
+// FNV-1a, used to fold every game's statistics into one digest
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+// Return the current time in nanoseconds
+static uint64_t now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Fold a 32-bit value into the digest
+static uint32_t hashValue(uint32_t hash, uint32_t value) {
+  for (uint8_t i = 0; i < sizeof(value); i++) {
+    hash ^= (value >> (8 * i)) & 0xFF;
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+// Run many complete games with no display and scripted touches, as fast as
+// the host allows. Every game is seeded from the base seed, so a run is
+// exactly repeatable: the printed digest only changes if the game logic does.
+int main(int argc, char *argv[]) {
+  uint32_t games = argc > 1 ? strtoul(argv[1], NULL, 0) : DEFAULT_GAMES;
+  uint32_t ticksPerGame =
+      argc > 2 ? strtoul(argv[2], NULL, 0) : DEFAULT_TICKS_PER_GAME;
+  uint32_t seed = argc > 3 ? strtoul(argv[3], NULL, 0) : DEFAULT_SEED;
+  bool render = argc > 4 ? strtoul(argv[4], NULL, 0) != 0 : DEFAULT_RENDER;
+
+  uint64_t updateNs = 0;
+  uint64_t renderNs = 0;
+  uint64_t maxTickNs = 0;
+  uint64_t launches = 0;
+  uint64_t interceptions = 0;
+  uint64_t impacts = 0;
+  uint64_t shots = 0;
+  uint32_t digest = FNV_OFFSET_BASIS;
+
+  display_init();
+  uint64_t runStart = now();
+
+  for (uint32_t game = 0; game < games; game++) {
+    gameRandom_seed(seed + game);
+    headless_clearTouches();
+    gameControl_init();
+
+    for (uint32_t tick = 0; tick < ticksPerGame; tick++) {
+      if (tick % TOUCH_INTERVAL_TICKS == 0)
+        headless_scriptTouch(gameRandom_next(DISPLAY_WIDTH),
+                             TOUCH_TOP_Y +
+                                 gameRandom_next(DISPLAY_HEIGHT - TOUCH_TOP_Y));
+
+      uint64_t start = now();
+      gameControl_update();
+      uint64_t updated = now();
+      if (render)
+        gameControl_render();
+      uint64_t rendered = now();
+
+      updateNs += updated - start;
+      renderNs += rendered - updated;
+      if (rendered - start > maxTickNs)
+        maxTickNs = rendered - start;
+    }
+
+    gameControl_stats_t stats;
+    gameControl_getStats(&stats);
+    launches += stats.enemyLaunches;
+    interceptions += stats.interceptions;
+    impacts += stats.impacts;
+    shots += stats.playerShots;
+
+    digest = hashValue(digest, stats.enemyLaunches);
+    digest = hashValue(digest, stats.interceptions);
+    digest = hashValue(digest, stats.impacts);
+    digest = hashValue(digest, stats.playerShots);
+  }
+
+  double runSeconds = (now() - runStart) * 1e-9;
+  uint64_t totalTicks = (uint64_t)games * ticksPerGame;
+
+  printf("Headless missile command: %u games of %u ticks, seed %u\n", games,
+         ticksPerGame, seed);
+  printf("  %.3f s, %.1f games/s\n", runSeconds, games / runSeconds);
+  if (totalTicks) {
+    printf("  update %.2f us/tick, render %.2f us/tick, worst tick %.2f us\n",
+           updateNs * 1e-3 / totalTicks, renderNs * 1e-3 / totalTicks,
+           maxTickNs * 1e-3);
+    printf("  %u display draw calls/tick\n",
+           (uint32_t)(headless_getDrawCallCount() / totalTicks));
+  }
+  printf("  %llu enemy launches, %llu interceptions (%.1f%%), %llu impacts, "
+         "%llu shots\n",
+         (unsigned long long)launches, (unsigned long long)interceptions,
+         launches ? 100.0 * interceptions / launches : 0.0,
+         (unsigned long long)impacts, (unsigned long long)shots);
+  printf("  digest %08x\n", digest);
+  return 0;
+}
@@ -2,6 +2,7 @@
 
 #include "config.h"
 #include "display.h"
+#include "idle.h"
 #include "interrupts.h"
 #include "intervalTimer.h"
 #include "missile.h"
@@ -52,7 +53,7 @@ int main() {
   for (uint16_t i = 0; i < CONFIG_MAX_TOTAL_MISSILES; i++)
     missile_init_dead(&missiles[i]);
 
-  // Main game loop
+  // Main game loop, run by the ISR. Sleep between interrupts.
   while (1)
-    ;
+    idle_wait();
 }
\ No newline at end of file
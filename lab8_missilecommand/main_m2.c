@@ -4,6 +4,7 @@
 
 #include "config.h"
 #include "gameControl.h"
+#include "idle.h"
 #include "interrupts.h"
 #include "intervalTimer.h"
 #include "touchscreen.h"
@@ -24,6 +25,9 @@ void game_isr() {
   isr_triggered_count++;
 }
 
+// True once the game ISR has raised the flag
+static bool interruptFlagSet() { return interrupt_flag; }
+
 // Interrupt handler for touchscreen - tick directly
 void touchscreen_isr() {
   intervalTimer_ackInterrupt(INTERVAL_TIMER_1);
@@ -52,13 +56,14 @@ int main() {
                               CONFIG_TOUCHSCREEN_TIMER_PERIOD);
   intervalTimer_enableInterrupt(INTERVAL_TIMER_0);
   intervalTimer_enableInterrupt(INTERVAL_TIMER_1);
+  idle_resetStats();
   intervalTimer_start(INTERVAL_TIMER_0);
   intervalTimer_start(INTERVAL_TIMER_1);
 
   // Main game loop
   while (isr_triggered_count < RUNTIME_TICKS) {
-    while (!interrupt_flag)
-      ;
+    // Sleep until the game ISR raises the flag
+    idle_waitUntil(interruptFlagSet);
     interrupt_flag = false;
     isr_handled_count++;
 
@@ -66,4 +71,5 @@ int main() {
   }
   printf("Handled %d of %d interrupts\n", isr_handled_count,
          isr_triggered_count);
+  idle_printStats();
 }
\ No newline at end of file
@@ -3,67 +3,78 @@
 #define MISSILE_COMMAND_PART3
 
 #include "config.h"
+#include "framePacer.h"
 #include "gameControl.h"
+#ifdef HEADLESS
+#include "headless.h"
+#endif
+#include "idle.h"
 #include "interrupts.h"
 #include "intervalTimer.h"
+#include "timerWheel.h"
 #include "touchscreen.h"
 
 #define RUNTIME_S 60
 #define RUNTIME_TICKS ((int)(RUNTIME_S / CONFIG_GAME_TIMER_PERIOD))
 
-volatile bool interrupt_flag;
+// Both timers run off one interval timer through the timer wheel
+static timerWheel_timer_t gameTimer;
+static timerWheel_timer_t touchscreenTimer;
 
-uint32_t isr_triggered_count;
-uint32_t isr_handled_count;
+// Game timer callback - only counts the tick, so the game runs in the main loop
+// and no tick is lost while the main loop is busy.
+void game_isr() { framePacer_tickIsr(); }
 
-// Interrupt handler for game - use flag method so that it can be interrupted by
-// the touchscreen tick while running.
-void game_isr() {
-  intervalTimer_ackInterrupt(INTERVAL_TIMER_0);
-  interrupt_flag = true;
-  isr_triggered_count++;
-}
-
-// Interrupt handler for touchscreen - tick directly
-void touchscreen_isr() {
-  intervalTimer_ackInterrupt(INTERVAL_TIMER_1);
-  touchscreen_tick();
-}
+// Touchscreen timer callback - tick directly
+void touchscreen_isr() { touchscreen_tick(); }
 
 // Milestone 3 test application
 int main() {
-  interrupt_flag = false;
-  isr_triggered_count = 0;
-  isr_handled_count = 0;
-
   display_init();
   touchscreen_init(CONFIG_TOUCHSCREEN_TIMER_PERIOD);
   gameControl_init();
 
-  // Initialize timer interrupts
+  // Initialize timer interrupts. Interval timer 0 drives the timer wheel,
+  // leaving timers 1 and 2 free.
   interrupts_init();
-  interrupts_register(INTERVAL_TIMER_0_INTERRUPT_IRQ, game_isr);
-  interrupts_register(INTERVAL_TIMER_1_INTERRUPT_IRQ, touchscreen_isr);
+  interrupts_register(INTERVAL_TIMER_0_INTERRUPT_IRQ, timerWheel_isr);
   interrupts_irq_enable(INTERVAL_TIMER_0_INTERRUPT_IRQ);
-  interrupts_irq_enable(INTERVAL_TIMER_1_INTERRUPT_IRQ);
 
-  intervalTimer_initCountDown(INTERVAL_TIMER_0, CONFIG_GAME_TIMER_PERIOD);
-  intervalTimer_initCountDown(INTERVAL_TIMER_1,
-                              CONFIG_TOUCHSCREEN_TIMER_PERIOD);
-  intervalTimer_enableInterrupt(INTERVAL_TIMER_0);
-  intervalTimer_enableInterrupt(INTERVAL_TIMER_1);
-  intervalTimer_start(INTERVAL_TIMER_0);
-  intervalTimer_start(INTERVAL_TIMER_1);
+  // Frame times and interrupt handlers are timed with the global timer
+  framePacer_init(CONFIG_GAME_TIMER_PERIOD);
+  interrupts_enableStats();
+
+  timerWheel_init(INTERVAL_TIMER_0, CONFIG_TIMER_WHEEL_TICK_PERIOD);
+  timerWheel_startPeriodic(&gameTimer, CONFIG_GAME_TIMER_PERIOD, game_isr);
+  timerWheel_startPeriodic(&touchscreenTimer, CONFIG_TOUCHSCREEN_TIMER_PERIOD,
+                           touchscreen_isr);
 
-  // Main game loop
-  while (isr_triggered_count < RUNTIME_TICKS) {
-    while (!interrupt_flag)
-      ;
-    interrupt_flag = false;
-    isr_handled_count++;
+  // Main game loop. The CPU sleeps in framePacer_waitForTicks() until the next
+  // tick.
+  idle_resetStats();
+  while (framePacer_getTickCount() < RUNTIME_TICKS) {
+    // Simulate every tick that has happened since the last frame
+    uint32_t ticks = framePacer_waitForTicks();
+    for (uint32_t i = 0; i < ticks; i++)
+      gameControl_update();
 
-    gameControl_tick();
+    // Draw the result, unless the pacer wants to defer it to catch up
+    if (framePacer_beginRender()) {
+      gameControl_render();
+      framePacer_endRender();
+    }
   }
-  printf("Handled %d of %d interrupts\n", isr_handled_count,
-         isr_triggered_count);
+#ifdef CONFIG_STRESS_MODE
+  printf("Stress mode: %d missiles\n", CONFIG_MAX_TOTAL_MISSILES);
+#endif
+  framePacer_printStats();
+  interrupts_printStats();
+  idle_printStats();
+  printf("Timer wheel: %lu interrupts in %lu ticks\n",
+         (unsigned long)timerWheel_getInterruptCount(),
+         (unsigned long)timerWheel_getTickCount());
+#ifdef HEADLESS
+  headless_printTimingReport();
+  headless_printRegisterProfile();
+#endif
 }
\ No newline at end of file
@@ -1,11 +1,18 @@
 #include "missile.h"
 #include "config.h"
 
-#include <math.h>
 #include <stdbool.h>
+#include <stdio.h>
 #include <stdlib.h>
 
 #include "display.h"
+#include "displayCircle.h"
+#include "gameRandom.h"
+#include "missilePool.h"
+
+// Explosions are drawn using the precomputed circle scanline tables
+_Static_assert(CONFIG_EXPLOSION_MAX_RADIUS <= DISPLAYCIRCLE_MAX_RADIUS,
+               "explosion radius is larger than the circle tables");
 
 // States defining the missile's behavior
 enum missile_st_t {
@@ -15,23 +22,92 @@ enum missile_st_t {
   dead_st
 };
 
+// Plane missile speeds were not defined in config
+#define PLANE_MISSILE_DISTANCE_PER_SECOND 50
+#define PLANE_MISSILE_DISTANCE_PER_TICK                                        \
+  (PLANE_MISSILE_DISTANCE_PER_SECOND * CONFIG_GAME_TIMER_PERIOD)
+
+// Missile speeds and explosion sizes in Q16.16 fixed point
+#define PLAYER_SPEED_FIXED                                                     \
+  MISSILEPOOL_TO_FIXED(CONFIG_PLAYER_MISSILE_DISTANCE_PER_TICK)
+#define ENEMY_SPEED_FIXED                                                      \
+  MISSILEPOOL_TO_FIXED(CONFIG_ENEMY_MISSILE_DISTANCE_PER_TICK)
+#define PLANE_SPEED_FIXED MISSILEPOOL_TO_FIXED(PLANE_MISSILE_DISTANCE_PER_TICK)
+#define RADIUS_CHANGE_FIXED                                                    \
+  MISSILEPOOL_TO_FIXED(CONFIG_EXPLOSION_RADIUS_CHANGE_PER_TICK)
+#define MAX_RADIUS_FIXED MISSILEPOOL_TO_FIXED(CONFIG_EXPLOSION_MAX_RADIUS)
+
+// Kinematics of every flying missile
+static missilePool_t pool;
+static bool poolInitialized = false;
+
 //////////////// Helper Functions ////////////////
 
+// Return whether the missile currently holds a slot in the pool. Checking the
+// slot's owner also guards against uninitialized slot numbers.
+static bool ownsSlot(missile_t *missile) {
+  return poolInitialized && missile->pool_slot >= 0 &&
+         missile->pool_slot < pool.count &&
+         pool.owner[missile->pool_slot] == missile;
+}
+
+// Give the missile's slot back to the pool
+static void releaseSlot(missile_t *missile) {
+  if (!ownsSlot(missile))
+    return;
+
+  // The last missile in the pool moves into the freed slot
+  missile_t *moved = missilePool_remove(&pool, missile->pool_slot);
+  if (moved != NULL)
+    moved->pool_slot = missile->pool_slot;
+  missile->pool_slot = MISSILEPOOL_NO_SLOT;
+}
+
+// Take a slot in the pool for a missile that is starting its flight
+static void acquireSlot(missile_t *missile) {
+  int32_t speed;
+
+  if (!poolInitialized)
+    missile_initPool(CONFIG_MAX_TOTAL_MISSILES);
+
+  // Determine missile speed from its type
+  if (missile->type == MISSILE_TYPE_PLAYER)
+    speed = PLAYER_SPEED_FIXED;
+  else if (missile->type == MISSILE_TYPE_ENEMY)
+    speed = ENEMY_SPEED_FIXED;
+  else
+    speed = PLANE_SPEED_FIXED;
+
+  // A missile can be relaunched while it is still flying
+  releaseSlot(missile);
+  missile->pool_slot = missilePool_add(
+      &pool, missile, missile->x_origin, missile->y_origin, missile->x_dest,
+      missile->y_dest, missile->total_length, speed);
+  if (missile->pool_slot == MISSILEPOOL_NO_SLOT)
+    printf("missile: pool is full, missile will not move\n");
+}
+
 // General missile member initialization that is independent
 // of the missile's type. Origin and destination of missile
 // must already be defined for calculations to be correct.
 void missile_init_general(missile_t *missile) {
   // Calculate the total length of the missile's trajectory
-  double x_len = (float)(missile->x_dest - missile->x_origin);
-  double y_len = (float)(missile->y_dest - missile->y_origin);
-  missile->total_length = (uint16_t)sqrt(pow(x_len, 2) + pow(y_len, 2));
+  int32_t x_len = missile->x_dest - missile->x_origin;
+  int32_t y_len = missile->y_dest - missile->y_origin;
+  missile->total_length = missilePool_sqrt(x_len * x_len + y_len * y_len);
 
   // Initialize other variables
-  missile->length = 0.0;
   missile->explode_me = false;
+  missile->radius = 0;
   missile->x_current = missile->x_origin;
   missile->y_current = missile->y_origin;
   missile->impacted = false;
+
+  // The previous flight may still be on screen, the next render cleans it up
+  missile->relaunched = true;
+
+  // Flying missiles are moved by the pool
+  acquireSlot(missile);
 }
 
 // Unlike most state machines that have a single `init` function, our missile
@@ -43,6 +119,15 @@ void missile_init_general(missile_t *missile) {
 void missile_init_dead(missile_t *missile) {
   // Only set the current state, member variables are set later
   missile->currentState = dead_st;
+
+  // A dead missile doesn't move
+  releaseSlot(missile);
+  missile->pool_slot = MISSILEPOOL_NO_SLOT;
+
+  // Nothing is on screen yet
+  displayLine_init(&missile->trail, 0, 0, 0, 0);
+  missile->radius_drawn = DISPLAYCIRCLE_NO_INNER_RADIUS;
+  missile->relaunched = false;
 }
 
 // Initialize the missile as an enemy missile.  This will randomly choose the
@@ -58,11 +143,11 @@ void missile_init_enemy(missile_t *missile) {
   missile->currentState = flying_st;
 
   // Randomly choose origin point in the top quarter of the display
-  missile->x_origin = rand() % DISPLAY_WIDTH;
-  missile->y_origin = rand() % ENEMY_ORIGIN_BOTTOM_CUTOFF;
+  missile->x_origin = gameRandom_next(DISPLAY_WIDTH);
+  missile->y_origin = gameRandom_next(ENEMY_ORIGIN_BOTTOM_CUTOFF);
 
   // Randomly choose destination point on the bottom edge of the display
-  missile->x_dest = rand() % DISPLAY_WIDTH;
+  missile->x_dest = gameRandom_next(DISPLAY_WIDTH);
   missile->y_dest = DISPLAY_HEIGHT;
 
   // Initialize other struct members
@@ -124,7 +209,7 @@ void missile_init_plane(missile_t *missile, int16_t plane_x, int16_t plane_y) {
   missile->y_origin = plane_y;
 
   // Randomly choose destination point on the bottom edge of the display
-  missile->x_dest = rand() % DISPLAY_WIDTH;
+  missile->x_dest = gameRandom_next(DISPLAY_WIDTH);
   missile->y_dest = DISPLAY_HEIGHT;
 
   // Initialize other struct members
@@ -133,54 +218,57 @@ void missile_init_plane(missile_t *missile, int16_t plane_x, int16_t plane_y) {
 
 ////////// State Machine TICK Function //////////
 
-// Plane missile speeds were not defined in config
-#define PLANE_MISSILE_DISTANCE_PER_SECOND 50
-#define PLANE_MISSILE_DISTANCE_PER_TICK                                        \
-  (PLANE_MISSILE_DISTANCE_PER_SECOND * CONFIG_GAME_TIMER_PERIOD)
-
-// Max radius of explosions
-#define MAX_EXPLOSION_RADIUS 25
-
 // Background color of game screen
 #define BACKGROUND_COLOR DISPLAY_BLACK
 
-// Missile speed is doubled because tick rate is halved
-#define TICK_RATE_FACTOR 2
+// Return the color the missile is drawn in.
+static uint16_t getMissileColor(missile_t *missile) {
+  if (missile->type == MISSILE_TYPE_PLAYER)
+    return CONFIG_COLOR_PLAYER;
+  else if (missile->type == MISSILE_TYPE_ENEMY)
+    return CONFIG_COLOR_ENEMY;
+  else
+    return CONFIG_COLOR_PLANE;
+}
 
-// Define state machine behavior of the missile
-void missile_tick(missile_t *missile) {
-  uint16_t missile_color;
-  double missile_distance_per_tick;
-  double percentage_traveled;
-
-  // Determine missile color and speed from its type
-  if (missile->type == MISSILE_TYPE_PLAYER) {
-    missile_color = CONFIG_COLOR_PLAYER;
-    missile_distance_per_tick = CONFIG_PLAYER_MISSILE_DISTANCE_PER_TICK;
-  } else if (missile->type == MISSILE_TYPE_ENEMY) {
-    missile_color = CONFIG_COLOR_ENEMY;
-    missile_distance_per_tick = CONFIG_ENEMY_MISSILE_DISTANCE_PER_TICK;
-  } else if (missile->type == MISSILE_TYPE_PLANE) {
-    missile_color = CONFIG_COLOR_PLANE;
-    missile_distance_per_tick = PLANE_MISSILE_DISTANCE_PER_TICK;
+// Grow or shrink the explosion circle on screen to the given radius. Only the
+// ring between the old and new radius is drawn: in the missile's color when
+// growing, in the background color when shrinking.
+static void drawExplosionRadius(missile_t *missile, int16_t radius,
+                                uint16_t color) {
+  if (radius > missile->radius_drawn) {
+    // A new explosion is centered where the missile is now
+    if (missile->radius_drawn == DISPLAYCIRCLE_NO_INNER_RADIUS) {
+      missile->x_drawn = missile->x_current;
+      missile->y_drawn = missile->y_current;
+    }
+    displayCircle_fillAnnulus(missile->x_drawn, missile->y_drawn,
+                              missile->radius_drawn, radius, color);
+  } else if (radius < missile->radius_drawn) {
+    displayCircle_fillAnnulus(missile->x_drawn, missile->y_drawn, radius,
+                              missile->radius_drawn, BACKGROUND_COLOR);
   }
+  missile->radius_drawn = radius;
+}
+
+// Update the missile state machine without drawing anything. The missile's
+// position in the pool must already have been advanced for this tick.
+static void updateState(missile_t *missile) {
+  bool arrived;
 
   // State transition control
   switch (missile->currentState) {
   case flying_st:
-    // Erase current missile path
-    display_drawLine(missile->x_origin, missile->y_origin, missile->x_current,
-                     missile->y_current, BACKGROUND_COLOR);
-
-    // Update missile's position
-    missile->length += (missile_distance_per_tick * TICK_RATE_FACTOR);
-    percentage_traveled = missile->length / missile->total_length;
-    missile->x_current =
-        missile->x_origin +
-        percentage_traveled * (missile->x_dest - missile->x_origin);
-    missile->y_current =
-        missile->y_origin +
-        percentage_traveled * (missile->y_dest - missile->y_origin);
+    // Copy the missile's position out of the pool. Once it arrives it sits
+    // exactly on its destination.
+    arrived = !ownsSlot(missile) || pool.ticksLeft[missile->pool_slot] == 0;
+    if (arrived) {
+      missile->x_current = missile->x_dest;
+      missile->y_current = missile->y_dest;
+    } else {
+      missile->x_current = MISSILEPOOL_FROM_FIXED(pool.x[missile->pool_slot]);
+      missile->y_current = MISSILEPOOL_FROM_FIXED(pool.y[missile->pool_slot]);
+    }
 
     // If missile's explosion flag is set, transition to the growing explosion
     // state
@@ -188,59 +276,50 @@ void missile_tick(missile_t *missile) {
       missile->currentState = explosion_grow_st;
     }
     // If a player missile has reached its destination, blow it up
-    else if (missile->type == MISSILE_TYPE_PLAYER &&
-             missile->length >= missile->total_length) {
+    else if (missile->type == MISSILE_TYPE_PLAYER && arrived) {
       missile->currentState = explosion_grow_st;
     }
     // If another missile has reached its destination, kill it without exploding
-    else if (missile->type != MISSILE_TYPE_PLAYER &&
-             missile->length >= missile->total_length) {
+    else if (missile->type != MISSILE_TYPE_PLAYER && arrived) {
       missile->impacted = true;
       missile->currentState = dead_st;
     }
-    // Otherwise, redraw the missile with the updated position and continue the
-    // missile's flight
+    // Otherwise, continue the missile's flight
     else {
-      display_drawLine(missile->x_origin, missile->y_origin, missile->x_current,
-                       missile->y_current, missile_color);
       missile->currentState = flying_st;
     }
+
+    // Only flying missiles need a slot in the pool
+    if (missile->currentState != flying_st)
+      releaseSlot(missile);
     break;
 
   case explosion_grow_st:
     // Increment radius
-    missile->radius +=
-        CONFIG_EXPLOSION_RADIUS_CHANGE_PER_TICK * TICK_RATE_FACTOR;
+    missile->radius += RADIUS_CHANGE_FIXED;
 
     // If explosion has reached max radius, start shrinking the explosion
-    if (missile->radius >= MAX_EXPLOSION_RADIUS) {
+    if (missile->radius >= MAX_RADIUS_FIXED) {
+      missile->radius = MAX_RADIUS_FIXED;
       missile->currentState = explosion_shrink_st;
     }
-    // Otherwise, continue drawing larger circles
+    // Otherwise, continue growing
     else {
-      display_fillCircle(missile->x_current, missile->y_current,
-                         (int16_t)missile->radius, missile_color);
       missile->currentState = explosion_grow_st;
     }
     break;
 
   case explosion_shrink_st:
-    // Erase current explosion circle
-    display_fillCircle(missile->x_current, missile->y_current,
-                       (int16_t)missile->radius, BACKGROUND_COLOR);
-
     // Decrement radius
-    missile->radius -=
-        CONFIG_EXPLOSION_RADIUS_CHANGE_PER_TICK * TICK_RATE_FACTOR;
+    missile->radius -= RADIUS_CHANGE_FIXED;
 
     // If explosion has fizzled out, the missile is dead
-    if (missile->radius <= 0.0) {
+    if (missile->radius <= 0) {
+      missile->radius = 0;
       missile->currentState = dead_st;
     }
-    // Otherwise, continue drawing smaller circles
+    // Otherwise, continue shrinking
     else {
-      display_fillCircle(missile->x_current, missile->y_current,
-                         (int16_t)missile->radius, missile_color);
       missile->currentState = explosion_shrink_st;
     }
     break;
@@ -248,20 +327,79 @@ void missile_tick(missile_t *missile) {
     // Just chill here until missile is re-initialized
     break;
   }
+}
 
-  // State action control (Moore actions are kinda cringe tbh)
-  switch (missile->currentState) {
-  case flying_st:
-    break;
-  case explosion_grow_st:
-    break;
-  case explosion_shrink_st:
-    break;
-  case dead_st:
-    break;
+// Allocate the pool that moves flying missiles.
+void missile_initPool(uint16_t capacity) {
+  if (poolInitialized)
+    missilePool_free(&pool);
+  missilePool_init(&pool, capacity);
+  poolInitialized = true;
+}
+
+// Update the missile state machine without drawing anything
+void missile_update(missile_t *missile) {
+  // Move just this missile
+  if (missile->currentState == flying_st && ownsSlot(missile))
+    missilePool_advanceOne(&pool, missile->pool_slot);
+
+  updateState(missile);
+}
+
+// Update every missile in the game without drawing anything.
+void missile_updateAll(missile_t missiles[], uint16_t count) {
+  // Move every flying missile in one pass over the pool
+  if (poolInitialized)
+    missilePool_advance(&pool);
+
+  for (uint16_t i = 0; i < count; i++)
+    updateState(&missiles[i]);
+}
+
+// Bring the screen up to date with the missile's state. Only the difference
+// from what was drawn last time is drawn, so several updates can be rendered
+// at once.
+void missile_render(missile_t *missile) {
+  uint16_t missile_color = getMissileColor(missile);
+
+  // Clean up the previous flight before drawing the new one
+  if (missile->relaunched) {
+    displayLine_erase(&missile->trail, BACKGROUND_COLOR);
+    if (missile->radius_drawn != DISPLAYCIRCLE_NO_INNER_RADIUS) {
+      displayLine_batchFlush();
+      drawExplosionRadius(missile, DISPLAYCIRCLE_NO_INNER_RADIUS,
+                          BACKGROUND_COLOR);
+    }
+    displayLine_init(&missile->trail, missile->x_origin, missile->y_origin,
+                     missile->x_dest, missile->y_dest);
+    missile->relaunched = false;
+  }
+
+  // Extend the trail while flying (only the newly covered pixels are drawn),
+  // erase it once the missile stops flying
+  if (missile->currentState == flying_st)
+    displayLine_extendTo(&missile->trail, missile->x_current,
+                         missile->y_current, missile_color);
+  else
+    displayLine_erase(&missile->trail, BACKGROUND_COLOR);
+
+  // Grow or shrink the explosion to the current radius
+  int16_t radius = missile_is_exploding(missile)
+                       ? MISSILEPOOL_FROM_FIXED(missile->radius)
+                       : DISPLAYCIRCLE_NO_INNER_RADIUS;
+  if (radius != missile->radius_drawn) {
+    // Explosions are drawn on top of any queued trail updates
+    displayLine_batchFlush();
+    drawExplosionRadius(missile, radius, missile_color);
   }
 }
 
+// Define state machine behavior of the missile
+void missile_tick(missile_t *missile) {
+  missile_update(missile);
+  missile_render(missile);
+}
+
 // Return whether the given missile is dead.
 bool missile_is_dead(missile_t *missile) {
   return (missile->currentState == dead_st);
@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "displayLine.h"
+
 /* The same missile structure will be used for all missiles in the game,
 so this enum is used to identify the type of missile */
 typedef enum {
@@ -35,14 +37,28 @@ typedef struct {
   int16_t x_current;
   int16_t y_current;
 
-  // While flying, this tracks the current length of the flight path
-  double length;
+  // While flying, the missile's slot in the missile pool (-1 if none)
+  int16_t pool_slot;
+
+  // While flying, this tracks which part of the trail is already on screen
+  displayLine_t trail;
 
   // While flying, this flag is used to indicate the missile should be detonated
   bool explode_me;
 
-  // While exploding, this tracks the current radius
-  double radius;
+  // While exploding, this tracks the current radius (Q16.16 fixed point)
+  int32_t radius;
+
+  // While exploding, the radius of the circle currently on screen (-1 if none)
+  int16_t radius_drawn;
+
+  // Center of the explosion circle currently on screen
+  int16_t x_drawn;
+  int16_t y_drawn;
+
+  // Set when the missile is re-initialized, so the next render erases what is
+  // left of the previous flight
+  bool relaunched;
 
   // Used for game statistics, this tracks whether the missile impacted the
   // ground.
@@ -77,8 +93,27 @@ void missile_init_player(missile_t *missile, uint16_t x_dest, uint16_t y_dest);
 void missile_init_plane(missile_t *missile, int16_t plane_x, int16_t plane_y);
 
 ////////// State Machine TICK Function //////////
+// Update and render the missile in one call.
 void missile_tick(missile_t *missile);
 
+// Allocate the pool that moves flying missiles, big enough for capacity
+// missiles in flight at once. This is called automatically (sized for
+// CONFIG_MAX_TOTAL_MISSILES) when the first missile is launched; call it before
+// launching any missile to use a different size.
+void missile_initPool(uint16_t capacity);
+
+// Advance the missile's state by one game tick without drawing anything.
+void missile_update(missile_t *missile);
+
+// Advance every missile by one game tick without drawing anything. All flying
+// missiles are moved in a single pass over the pool, so every missile in the
+// game must be in the given array (and must not also be updated individually).
+void missile_updateAll(missile_t missiles[], uint16_t count);
+
+// Draw the difference between what is on screen and the missile's current
+// state. Any number of updates can happen between renders.
+void missile_render(missile_t *missile);
+
 // Return whether the given missile is dead.
 bool missile_is_dead(missile_t *missile);
 
@@ -0,0 +1,133 @@
+#include "missilePool.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+////////// Helper Functions //////////
+
+// Allocate one of the pool's arrays, dying with a message if malloc() fails.
+static void *allocateArray(uint16_t capacity, size_t elementSize) {
+  void *array = malloc(capacity * elementSize);
+  if (array == NULL) {
+    printf("missilePool_init: malloc failed for %u slots\n", capacity);
+    assert(false);
+  }
+  return array;
+}
+
+////////// Header Functions //////////
+
+// Allocate the arrays for a pool with the given number of slots.
+void missilePool_init(missilePool_t *pool, uint16_t capacity) {
+  pool->capacity = capacity;
+  pool->count = 0;
+  pool->x = allocateArray(capacity, sizeof(int32_t));
+  pool->y = allocateArray(capacity, sizeof(int32_t));
+  pool->dx = allocateArray(capacity, sizeof(int32_t));
+  pool->dy = allocateArray(capacity, sizeof(int32_t));
+  pool->ticksLeft = allocateArray(capacity, sizeof(uint16_t));
+  pool->owner = allocateArray(capacity, sizeof(void *));
+}
+
+// Free the arrays of a pool.
+void missilePool_free(missilePool_t *pool) {
+  free(pool->x);
+  free(pool->y);
+  free(pool->dx);
+  free(pool->dy);
+  free(pool->ticksLeft);
+  free(pool->owner);
+  pool->capacity = 0;
+  pool->count = 0;
+}
+
+// Add a missile flying from (x0, y0) to (x1, y1).
+int16_t missilePool_add(missilePool_t *pool, void *owner, int16_t x0,
+                        int16_t y0, int16_t x1, int16_t y1, uint16_t length,
+                        int32_t speed) {
+  if (pool->count == pool->capacity)
+    return MISSILEPOOL_NO_SLOT;
+
+  uint16_t slot = pool->count++;
+  pool->owner[slot] = owner;
+  pool->x[slot] = MISSILEPOOL_TO_FIXED(x0);
+  pool->y[slot] = MISSILEPOOL_TO_FIXED(y0);
+
+  // The step covers `speed` pixels along the path, split between x and y in
+  // proportion to the path's direction
+  if (length == 0) {
+    pool->dx[slot] = 0;
+    pool->dy[slot] = 0;
+    pool->ticksLeft[slot] = 1;
+    return slot;
+  }
+  pool->dx[slot] = (int64_t)(x1 - x0) * speed / length;
+  pool->dy[slot] = (int64_t)(y1 - y0) * speed / length;
+
+  // Round up, the missile arrives on the tick that reaches or passes the end
+  int64_t fixedLength = MISSILEPOOL_TO_FIXED((int64_t)length);
+  pool->ticksLeft[slot] = (fixedLength + speed - 1) / speed;
+  return slot;
+}
+
+// Remove the missile in the given slot, moving the last missile into it.
+void *missilePool_remove(missilePool_t *pool, uint16_t slot) {
+  uint16_t last = --pool->count;
+  if (slot == last)
+    return NULL;
+
+  pool->x[slot] = pool->x[last];
+  pool->y[slot] = pool->y[last];
+  pool->dx[slot] = pool->dx[last];
+  pool->dy[slot] = pool->dy[last];
+  pool->ticksLeft[slot] = pool->ticksLeft[last];
+  pool->owner[slot] = pool->owner[last];
+  return pool->owner[slot];
+}
+
+// Advance every missile in the pool by one tick, in a single pass.
+void missilePool_advance(missilePool_t *pool) {
+  int32_t *x = pool->x;
+  int32_t *y = pool->y;
+  const int32_t *dx = pool->dx;
+  const int32_t *dy = pool->dy;
+  uint16_t *ticksLeft = pool->ticksLeft;
+
+  for (uint16_t i = 0; i < pool->count; i++) {
+    x[i] += dx[i];
+    y[i] += dy[i];
+    if (ticksLeft[i])
+      ticksLeft[i]--;
+  }
+}
+
+// Advance only the missile in the given slot by one tick.
+void missilePool_advanceOne(missilePool_t *pool, uint16_t slot) {
+  pool->x[slot] += pool->dx[slot];
+  pool->y[slot] += pool->dy[slot];
+  if (pool->ticksLeft[slot])
+    pool->ticksLeft[slot]--;
+}
+
+// Integer square root, rounded down (bit-by-bit method).
+uint16_t missilePool_sqrt(uint32_t n) {
+  uint32_t root = 0;
+  uint32_t bit = 1UL << 30;
+
+  // Start at the highest power of four that fits
+  while (bit > n)
+    bit >>= 2;
+
+  while (bit) {
+    if (n >= root + bit) {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
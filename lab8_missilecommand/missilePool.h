@@ -0,0 +1,58 @@
+#ifndef MISSILEPOOL
+#define MISSILEPOOL
+
+#include <stdint.h>
+
+// Q16.16 fixed point: 16 integer bits, 16 fractional bits.
+#define MISSILEPOOL_FIXED_SHIFT 16
+#define MISSILEPOOL_TO_FIXED(x)                                                \
+  ((int32_t)((x) * (1 << MISSILEPOOL_FIXED_SHIFT)))
+#define MISSILEPOOL_FROM_FIXED(x) ((int16_t)((x) >> MISSILEPOOL_FIXED_SHIFT))
+
+// Returned by missilePool_add() when the pool is full.
+#define MISSILEPOOL_NO_SLOT -1
+
+// Kinematics of every flying missile, stored as a structure of arrays so the
+// per-tick update walks each array linearly. Flying missiles are kept packed
+// in slots [0, count); removing a missile moves the last one into its slot.
+typedef struct {
+  uint16_t capacity; // Number of slots allocated
+  uint16_t count;    // Number of slots in use
+
+  int32_t *x;          // Current x position (Q16.16)
+  int32_t *y;          // Current y position (Q16.16)
+  int32_t *dx;         // x distance moved per tick (Q16.16)
+  int32_t *dy;         // y distance moved per tick (Q16.16)
+  uint16_t *ticksLeft; // Ticks until the missile reaches its destination
+  void **owner;        // The missile each slot belongs to
+} missilePool_t;
+
+// Allocate the arrays for a pool with the given number of slots. Prints an
+// error message and asserts if malloc() fails.
+void missilePool_init(missilePool_t *pool, uint16_t capacity);
+
+// Free the arrays of a pool.
+void missilePool_free(missilePool_t *pool);
+
+// Add a missile flying from (x0, y0) to (x1, y1), whose full path is length
+// pixels long, at speed pixels per tick (Q16.16). owner identifies the missile
+// to the caller. Returns the slot, or MISSILEPOOL_NO_SLOT if full.
+int16_t missilePool_add(missilePool_t *pool, void *owner, int16_t x0,
+                        int16_t y0, int16_t x1, int16_t y1, uint16_t length,
+                        int32_t speed);
+
+// Remove the missile in the given slot. The last missile in the pool is moved
+// into the slot; its owner is returned so the caller can update its slot
+// number (NULL if the removed missile was the last one).
+void *missilePool_remove(missilePool_t *pool, uint16_t slot);
+
+// Advance every missile in the pool by one tick, in a single pass.
+void missilePool_advance(missilePool_t *pool);
+
+// Advance only the missile in the given slot by one tick.
+void missilePool_advanceOne(missilePool_t *pool, uint16_t slot);
+
+// Integer square root, rounded down.
+uint16_t missilePool_sqrt(uint32_t n);
+
+#endif /* MISSILEPOOL */
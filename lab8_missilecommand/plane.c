@@ -1,6 +1,7 @@
 #include "plane.h"
 #include "config.h"
 #include "display.h"
+#include "gameRandom.h"
 #include "missile.h"
 
 #include <stdbool.h>
@@ -33,6 +34,10 @@ static missile_t *missile;  // Pointer to the plane's missile
 static uint16_t fire_x_pos; // X position that the plane should fire the missile
 static bool missile_fired;  // Indicates whether the missile has been fired
 
+static bool drawn;              // Whether the plane is on screen
+static int16_t drawn_x_pos;     // X position of the plane on screen
+static bool drawn_facing_right; // Direction of the plane on screen
+
 static bool explode_me;           // Indicates when the plane should be exploded
 static uint16_t dead_ticks_count; // Number of ticks the plane has been dead
 static uint16_t dead_ticks_total; // Total number of ticks before respawn
@@ -69,8 +74,8 @@ static bool plane_canFireMissile() {
     return false;
 }
 
-// Draws (or erases) the plane at the current position
-static void plane_drawPlane(bool erase) {
+// Draws (or erases) the plane at the given position
+static void plane_drawPlane(int16_t x_pos, bool facing_right, bool erase) {
   int16_t vertex_x1, vertex_y1;
   int16_t vertex_x2, vertex_y2;
   int16_t vertex_x3, vertex_y3;
@@ -150,14 +155,15 @@ static void debugStatePrint() {
 void plane_init(missile_t *plane_missile) {
   // Randomize the cooldown timer before spawn
   uint16_t dead_time_total_secs =
-      rand() % (MAX_COOLDOWN_SECS - MIN_COOLDOWN_SECS) + MIN_COOLDOWN_SECS;
+      gameRandom_next(MAX_COOLDOWN_SECS - MIN_COOLDOWN_SECS) +
+      MIN_COOLDOWN_SECS;
   dead_ticks_total = dead_time_total_secs / CONFIG_GAME_TIMER_PERIOD;
 
   // Randomize the direction the plane is facing
-  facing_right = rand() % NUM_DIRECTIONS;
+  facing_right = gameRandom_next(NUM_DIRECTIONS);
 
   // Randomize the firing location in the middle half of the screen
-  fire_x_pos = rand() % DISPLAY_HALF_WIDTH + DISPLAY_QUARTER_WIDTH;
+  fire_x_pos = gameRandom_next(DISPLAY_HALF_WIDTH) + DISPLAY_QUARTER_WIDTH;
 
   // Initialize starting position based on direction
   x_pos =
@@ -173,8 +179,8 @@ void plane_init(missile_t *plane_missile) {
   currentState = dead_st;
 }
 
-// State machine tick function
-void plane_tick() {
+// Update the plane state machine without drawing anything
+void plane_update() {
   // debugStatePrint();
 
   // State transition control
@@ -184,7 +190,6 @@ void plane_tick() {
     // has been raised, erase the missile and re-initialze the plane
     // to the dead state
     if (plane_isOffscreen() || explode_me) {
-      plane_drawPlane(true);
       plane_init(missile);
       currentState = dead_st;
     }
@@ -219,17 +224,13 @@ void plane_tick() {
 
   // State action control
   switch (currentState) {
-  // Erase the plane, increment the position, and draw the plane
+  // Increment the position
   case flying_st:
-    plane_drawPlane(true);
-
     // Move left or right depending on the faced direction
     if (facing_right)
       x_pos += CONFIG_PLANE_DISTANCE_PER_TICK;
     else
       x_pos -= CONFIG_PLANE_DISTANCE_PER_TICK;
-
-    plane_drawPlane(false);
     break;
 
   // Increment the cooldown counter
@@ -239,6 +240,36 @@ void plane_tick() {
   }
 }
 
+// Bring the plane on screen up to date with its current position
+void plane_render() {
+  bool flying = (currentState == flying_st);
+
+  // Nothing to do if the plane hasn't moved
+  if (drawn && flying && drawn_x_pos == x_pos &&
+      drawn_facing_right == facing_right)
+    return;
+
+  // Erase the plane where it was last drawn
+  if (drawn) {
+    plane_drawPlane(drawn_x_pos, drawn_facing_right, true);
+    drawn = false;
+  }
+
+  // Draw the plane at its new position
+  if (flying) {
+    plane_drawPlane(x_pos, facing_right, false);
+    drawn_x_pos = x_pos;
+    drawn_facing_right = facing_right;
+    drawn = true;
+  }
+}
+
+// State machine tick function
+void plane_tick() {
+  plane_update();
+  plane_render();
+}
+
 // Trigger the plane to expode
 void plane_explode() { explode_me = true; }
 
@@ -9,9 +9,16 @@
 // missile)
 void plane_init(missile_t *plane_missile);
 
-// State machine tick function
+// State machine tick function, updates and renders the plane
 void plane_tick();
 
+// Advance the plane by one game tick without drawing anything
+void plane_update();
+
+// Draw the plane at its current position, erasing it from where it was last
+// drawn
+void plane_render();
+
 // Trigger the plane to expode
 void plane_explode();
 
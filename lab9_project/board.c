@@ -2,40 +2,201 @@
 #include "config.h"
 #include "graphics.h"
 
+#include <assert.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
-// TODO: Figure out if I can get rid of this one
-// // Initializes the board with empty tiles
-// void board_initEmpty(board_t *board) {
-//     location_t currLocation;
+// The bitmaps hold one row per byte, and arena slots fit in a byte
+static_assert(CONFIG_BOARD_WIDTH_TILES <= 8, "board rows must fit in a byte");
+static_assert(BOARD_MAX_ENTITIES < BOARD_NO_ENTITY, "arena slots must fit in a byte");
 
-//     // Iterate through each row of the board
-//     for (int col = 0; col < CONFIG_BOARD_WIDTH_TILES; col++) {
-//         currLocation.x = col;
+// Copies of a byte in every byte of a word
+#define EVERY_ROW(byte) (0x0101010101010101ULL * (byte))
 
-//         // Iterate through each column of the board
-//         for (int row = 0; row < CONFIG_BOARD_WIDTH_TILES; row++) {
-//             currLocation.y = row;
-//             entity_initEmpty(board, currLocation);
+// Tiles on the board, so shifted bits that land off the edges can be dropped
+#define ROW_MASK ((uint8_t)((1 << CONFIG_BOARD_WIDTH_TILES) - 1))
 
-//         }
-//     }
-// }
+static const uint16_t colors[ENTITY_NUM_COLORS] = ENTITY_COLORS;
+
+/*********************** Bitmap helpers ***********************/
+
+// Returns row y of a bitmap
+static uint8_t getRow(const board_bitmap_t bitmap, uint8_t y) {
+    return bitmap[y / BOARD_ROWS_PER_WORD] >> (y % BOARD_ROWS_PER_WORD * 8);
+}
+
+// Sets the bits in mask in row y of a bitmap
+static void setRowBits(board_bitmap_t bitmap, uint8_t y, uint8_t mask) {
+    bitmap[y / BOARD_ROWS_PER_WORD] |= (uint64_t)mask << (y % BOARD_ROWS_PER_WORD * 8);
+}
+
+// Clears the bits in mask in row y of a bitmap
+static void clearRowBits(board_bitmap_t bitmap, uint8_t y, uint8_t mask) {
+    bitmap[y / BOARD_ROWS_PER_WORD] &= ~((uint64_t)mask << (y % BOARD_ROWS_PER_WORD * 8));
+}
+
+// Moves the bits in mask from row y to row y + 1 of a bitmap
+static void dropRowBits(board_bitmap_t bitmap, uint8_t y, uint8_t mask) {
+    uint8_t falling = getRow(bitmap, y) & mask;
+    clearRowBits(bitmap, y, falling);
+    setRowBits(bitmap, y + 1, falling);
+}
+
+// Sets out to the bitmap moved up by rows rows (1 to 7): row y of out is
+// row y + rows of in
+static void shiftRowsUp(const board_bitmap_t in, board_bitmap_t out, uint8_t rows) {
+    for (uint8_t i = 0; i < BOARD_WORDS; i++) {
+        out[i] = in[i] >> (rows * 8);
+        if (i + 1 < BOARD_WORDS)
+            out[i] |= in[i + 1] << (64 - rows * 8);
+    }
+}
+
+// Sets out to the bitmap moved down by rows rows (1 to 7): row y + rows of out
+// is row y of in
+static void shiftRowsDown(const board_bitmap_t in, board_bitmap_t out, uint8_t rows) {
+    for (uint8_t i = 0; i < BOARD_WORDS; i++) {
+        out[i] = in[i] << (rows * 8);
+        if (i > 0)
+            out[i] |= in[i - 1] >> (64 - rows * 8);
+    }
+}
+
+// Adds the runs of BOARD_MATCH_LENGTH or more tiles of one color to matches.
+// Each row is a byte, so shifting a whole word by one bit shifts 8 rows at
+// once; the mask drops the bits that crossed into the neighboring row.
+static void findColorMatches(const board_bitmap_t tiles, board_bitmap_t matches) {
+    board_bitmap_t starts;
+    board_bitmap_t shifted;
+
+    // Horizontal: a run starts at every tile whose next 3 tiles to the right
+    // are also set. A start is at most 3 tiles from the end of its row, so
+    // spreading it to the right never crosses into the next row.
+    for (uint8_t i = 0; i < BOARD_WORDS; i++) {
+        uint64_t start = tiles[i];
+        for (uint8_t k = 1; k < BOARD_MATCH_LENGTH; k++)
+            start &= (tiles[i] >> k) & EVERY_ROW(0xFF >> k);
+        for (uint8_t k = 0; k < BOARD_MATCH_LENGTH; k++)
+            matches[i] |= start << k;
+    }
+
+    // Vertical: a run starts at every tile whose next 3 tiles down are also set
+    memcpy(starts, tiles, sizeof(board_bitmap_t));
+    for (uint8_t k = 1; k < BOARD_MATCH_LENGTH; k++) {
+        shiftRowsUp(tiles, shifted, k);
+        for (uint8_t i = 0; i < BOARD_WORDS; i++)
+            starts[i] &= shifted[i];
+    }
+    for (uint8_t i = 0; i < BOARD_WORDS; i++)
+        matches[i] |= starts[i];
+    for (uint8_t k = 1; k < BOARD_MATCH_LENGTH; k++) {
+        shiftRowsDown(starts, shifted, k);
+        for (uint8_t i = 0; i < BOARD_WORDS; i++)
+            matches[i] |= shifted[i];
+    }
+}
+
+/*********************** Arena helpers ***********************/
+
+// Takes an unused slot out of the arena
+static uint8_t allocateSlot(board_t *board) {
+    assert(board->freeCount > 0);
+    return board->freeSlots[--board->freeCount];
+}
+
+// Returns an entity's slot to the arena
+static void freeSlot(board_t *board, uint8_t slot) {
+    board->entities[slot].type = ENTITY_EMPTY;
+    board->freeSlots[board->freeCount++] = slot;
+}
+
+// Clears every link to or from the tile at location
+static void unlinkTile(board_t *board, location_t location) {
+    uint8_t bit = 1 << location.x;
+    clearRowBits(board->linkedRight, location.y, bit | bit >> 1);
+    clearRowBits(board->linkedDown, location.y, bit);
+    if (location.y > 0)
+        clearRowBits(board->linkedDown, location.y - 1, bit);
+}
+
+// Finds the pill half joined to the one at location. Returns false if there
+// is none.
+static bool getPartner(board_t *board, location_t location, location_t *partner) {
+    uint8_t bit = 1 << location.x;
+    *partner = location;
+
+    if (getRow(board->linkedRight, location.y) & bit)
+        partner->x++;
+    else if (getRow(board->linkedRight, location.y) & bit >> 1)
+        partner->x--;
+    else if (getRow(board->linkedDown, location.y) & bit)
+        partner->y++;
+    else if (location.y > 0 && getRow(board->linkedDown, location.y - 1) & bit)
+        partner->y--;
+    else
+        return false;
+    return true;
+}
+
+// Draws the entity at location, with a pill half shaped by its link
+static void drawEntity(board_t *board, location_t location) {
+    entity_t *entity = board_getEntity(board, location);
+    location_t partner;
+    drMarioDisplay_halfShape_t shape = DRMARIODISPLAY_HALF_SINGLE;
+
+    if (entity->type == ENTITY_VIRUS) {
+        drMarioDisplay_drawVirus(entity);
+        return;
+    }
+
+    if (getPartner(board, location, &partner)) {
+        if (partner.x > location.x)
+            shape = DRMARIODISPLAY_HALF_LEFT;
+        else if (partner.x < location.x)
+            shape = DRMARIODISPLAY_HALF_RIGHT;
+        else if (partner.y > location.y)
+            shape = DRMARIODISPLAY_HALF_TOP;
+        else
+            shape = DRMARIODISPLAY_HALF_BOTTOM;
+    }
+    drMarioDisplay_drawPillHalf(entity, shape);
+}
+
+// Removes the entity at location from the bitmaps and the arena
+static void removeEntity(board_t *board, location_t location) {
+    uint8_t slot = board->tiles[location.x][location.y];
+    if (slot == BOARD_NO_ENTITY)
+        return;
+
+    uint8_t bit = 1 << location.x;
+    for (uint8_t c = 0; c < ENTITY_NUM_COLORS; c++)
+        clearRowBits(board->colors[c], location.y, bit);
+    clearRowBits(board->viruses, location.y, bit);
+    unlinkTile(board, location);
+
+    board->tiles[location.x][location.y] = BOARD_NO_ENTITY;
+    freeSlot(board, slot);
+}
+
+/*********************** Board functions ***********************/
 
 // Initializes the board with empty tiles
 void board_initEmpty(board_t *board) {
-    // Iterate through each row of the board
-    for (int col = 0; col < CONFIG_BOARD_WIDTH_TILES; col++) {
-        // Iterate through each column in this row
-        for (int row = 0; row < CONFIG_BOARD_HEIGHT_TILES; row++) {
-            board->tiles[col][row] = NULL;
-        }
-    }
+    memset(board->colors, 0, sizeof(board->colors));
+    memset(board->viruses, 0, sizeof(board->viruses));
+    memset(board->linkedRight, 0, sizeof(board->linkedRight));
+    memset(board->linkedDown, 0, sizeof(board->linkedDown));
+    memset(board->tiles, BOARD_NO_ENTITY, sizeof(board->tiles));
+
+    // Hand out low slots first
+    board->freeCount = 0;
+    for (int slot = BOARD_MAX_ENTITIES - 1; slot >= 0; slot--)
+        freeSlot(board, slot);
 }
 
 // Initializes the board with the specified number of viruses
 void board_initViruses(board_t *board, uint8_t numViruses) {
-    uint16_t colors[ENTITY_NUM_COLORS] = {ENTITY_COLOR_RED, ENTITY_COLOR_BLUE, ENTITY_COLOR_YELLOW};
     uint16_t color;
     location_t location;
 
@@ -47,13 +208,13 @@ void board_initViruses(board_t *board, uint8_t numViruses) {
         color = colors[colorIndex];
 
         // Generate viruses of this color in positions below the cutoff line
-        for (int i = 0; i < CONFIG_NUM_VIRUSES / 3; i++) {
+        for (int i = 0; i < numViruses / ENTITY_NUM_COLORS; i++) {
             // Randomize virus position
             location.x = rand() % CONFIG_BOARD_WIDTH_TILES;
             location.y = rand() % (CONFIG_BOARD_HEIGHT_TILES - CONFIG_VIRUS_TOP_CUTOFF) + CONFIG_VIRUS_TOP_CUTOFF;
 
             // Only place in this location if it is unoccupied
-            if (board->tiles[location.x][location.y] == NULL)
+            if (!board_isOccupied(board, location))
                 entity_initVirus(board, location, color);
 
             // Otherwise decrement the counter and place somewhere else
@@ -62,53 +223,221 @@ void board_initViruses(board_t *board, uint8_t numViruses) {
     }
 }
 
-// TODO: might not use this function after all
-// Creates an empty tile at this location
+// Returns the entity at this location, or NULL if the tile is empty
+entity_t *board_getEntity(board_t *board, location_t location) {
+    uint8_t slot = board->tiles[location.x][location.y];
+    return slot == BOARD_NO_ENTITY ? NULL : &board->entities[slot];
+}
+
+// Returns true if something occupies this location
+bool board_isOccupied(board_t *board, location_t location) {
+    return board->tiles[location.x][location.y] != BOARD_NO_ENTITY;
+}
+
+// Returns one of the entity colors at random
+uint16_t board_getRandomColor() {
+    return colors[rand() % ENTITY_NUM_COLORS];
+}
+
+// Places a new entity on an empty tile and returns it
+entity_t *board_addEntity(board_t *board, entity_type_t type, location_t location, uint16_t color) {
+    assert(!board_isOccupied(board, location));
+
+    uint8_t slot = allocateSlot(board);
+    entity_t *entity = &board->entities[slot];
+    entity->type = type;
+    entity->location = location;
+    entity->color = color;
+
+    board->tiles[location.x][location.y] = slot;
+    setRowBits(board->colors[entity_getColorIndex(color)], location.y, 1 << location.x);
+    if (type == ENTITY_VIRUS)
+        setRowBits(board->viruses, location.y, 1 << location.x);
+    return entity;
+}
+
+// Joins two pill halves on neighboring tiles
+void board_linkPillHalves(board_t *board, entity_t *half1, entity_t *half2) {
+    // Links are stored on the left or top half
+    if (half2->location.x < half1->location.x || half2->location.y < half1->location.y) {
+        entity_t *swap = half1;
+        half1 = half2;
+        half2 = swap;
+    }
+
+    if (half2->location.x == half1->location.x + 1 && half2->location.y == half1->location.y)
+        setRowBits(board->linkedRight, half1->location.y, 1 << half1->location.x);
+    else if (half2->location.x == half1->location.x && half2->location.y == half1->location.y + 1)
+        setRowBits(board->linkedDown, half1->location.y, 1 << half1->location.x);
+    else
+        assert(false);
+}
+
+// Finds every run of matching tiles in a row or column
+bool board_findMatches(board_t *board, board_bitmap_t matches) {
+    uint64_t any = 0;
+
+    memset(matches, 0, sizeof(board_bitmap_t));
+    for (uint8_t c = 0; c < ENTITY_NUM_COLORS; c++)
+        findColorMatches(board->colors[c], matches);
+
+    for (uint8_t i = 0; i < BOARD_WORDS; i++)
+        any |= matches[i];
+    return any != 0;
+}
+
+// Removes every entity in matches
+uint8_t board_clearMatches(board_t *board, board_bitmap_t matches) {
+    uint8_t virusCount = 0;
+    location_t location;
+
+    for (uint8_t i = 0; i < BOARD_WORDS; i++) {
+        virusCount += __builtin_popcountll(matches[i] & board->viruses[i]);
+
+        // Visit each matched tile, lowest bit first
+        for (uint64_t left = matches[i]; left; left &= left - 1) {
+            uint8_t bit = __builtin_ctzll(left);
+            location.x = bit % 8;
+            location.y = i * BOARD_ROWS_PER_WORD + bit / 8;
+
+            // A half whose partner is removed is drawn on its own
+            location_t partner;
+            bool hasPartner = getPartner(board, location, &partner);
+            removeEntity(board, location);
+            drMarioDisplay_clearTile(location);
+            if (hasPartner && board_isOccupied(board, partner))
+                drawEntity(board, partner);
+        }
+    }
+    return virusCount;
+}
+
+// Drops every unsupported pill half by one tile. Rows are handled from the
+// bottom up, so a row sees the row below it after that row has fallen, and a
+// whole unsupported stack falls together.
+bool board_applyGravity(board_t *board) {
+    bool moved = false;
+    location_t from;
+    location_t to;
+
+    for (int y = CONFIG_BOARD_HEIGHT_TILES - 2; y >= 0; y--) {
+        uint8_t occupied = 0;
+        uint8_t below = 0;
+        for (uint8_t c = 0; c < ENTITY_NUM_COLORS; c++) {
+            occupied |= getRow(board->colors[c], y);
+            below |= getRow(board->colors[c], y + 1);
+        }
+
+        // Pill halves with nothing under them
+        uint8_t falling = occupied & ~getRow(board->viruses, y) & ~below;
+
+        // A pair of halves side by side only falls if both of them can
+        uint8_t pairs = getRow(board->linkedRight, y);
+        uint8_t stuck = pairs & ~(falling & falling >> 1);
+        falling &= ~(stuck | stuck << 1) & ROW_MASK;
+        if (!falling)
+            continue;
+        moved = true;
+
+        for (uint8_t c = 0; c < ENTITY_NUM_COLORS; c++)
+            dropRowBits(board->colors[c], y, falling);
+        dropRowBits(board->linkedRight, y, falling);
+        dropRowBits(board->linkedDown, y, falling);
+
+        // Follow the bits with the entities
+        for (uint8_t left = falling; left; left &= left - 1) {
+            from.x = __builtin_ctz(left);
+            from.y = y;
+
+            uint8_t slot = board->tiles[from.x][from.y];
+            board->tiles[from.x][y + 1] = slot;
+            board->tiles[from.x][from.y] = BOARD_NO_ENTITY;
+            board->entities[slot].location.y++;
+        }
+
+        // Redraw once the whole row has moved. The bottom half of a standing
+        // pill was drawn on its own when it moved, before its partner's link
+        // did, so partners are redrawn too.
+        for (uint8_t left = falling; left; left &= left - 1) {
+            from.x = __builtin_ctz(left);
+            from.y = y;
+            to.x = from.x;
+            to.y = y + 1;
+
+            location_t partner;
+            drMarioDisplay_clearTile(from);
+            drawEntity(board, to);
+            if (getPartner(board, to, &partner))
+                drawEntity(board, partner);
+        }
+    }
+    return moved;
+}
+
+// Clears matches and lets everything fall until the board is stable
+uint8_t board_resolve(board_t *board) {
+    board_bitmap_t matches;
+    uint8_t virusCount = 0;
+
+    while (board_findMatches(board, matches)) {
+        virusCount += board_clearMatches(board, matches);
+        while (board_applyGravity(board))
+            ;
+    }
+    return virusCount;
+}
+
+/*********************** Entity functions ***********************/
+
+// Removes whatever is at this location, leaving an empty tile
 void entity_initEmpty(board_t *board, location_t location) {
-    entity_t newEntity;
-    newEntity.location = location;
-    newEntity.type = ENTITY_EMPTY;
-    newEntity.color = ENTITY_COLOR_EMPTY;
-    board->tiles[location.x][location.y] = &newEntity;
+    removeEntity(board, location);
 }
 
 // Creates a virus at this location with the given color
 void entity_initVirus(board_t *board, location_t location, uint16_t color) {
-    // Generate the virus
-    entity_t newVirus;
-    newVirus.location = location;
-    newVirus.type = ENTITY_VIRUS;
-    newVirus.color = color;
-
     // Place and draw the virus
-    board->tiles[location.x][location.y] = &newVirus;
-    drMarioDisplay_drawVirus(&newVirus);
+    entity_t *virus = board_addEntity(board, ENTITY_VIRUS, location, color);
+    drMarioDisplay_drawVirus(virus);
+}
+
+// Returns the position of a color in ENTITY_COLORS
+uint8_t entity_getColorIndex(uint16_t color) {
+    for (uint8_t i = 0; i < ENTITY_NUM_COLORS; i++) {
+        if (colors[i] == color)
+            return i;
+    }
+    assert(false);
+    return 0;
 }
 
 // Randomizes the given entity's color
 void entity_randomizeColor(entity_t *entity) {
-    uint8_t colorCode = rand() % 3;
-
-    // Choose the color from the randomized code
-    switch (colorCode) {
-        case 0: entity->color = ENTITY_COLOR_RED;
-        case 1: entity->color = ENTITY_COLOR_BLUE;
-        case 2: entity->color = ENTITY_COLOR_YELLOW;
-    }
+    entity->color = board_getRandomColor();
 }
 
 // Moves the entity to the given location
 void entity_move(board_t *board, entity_t *entity, location_t location) {
-    // Clear the entity's current position if within bounds
-    if (entity->location.x < CONFIG_BOARD_WIDTH_TILES && entity->location.y < CONFIG_BOARD_HEIGHT_TILES) {
-        board->tiles[entity->location.x][entity->location.y] = NULL;
-        drMarioDisplay_clearTile(entity->location);  
-    }
+    location_t from = entity->location;
+    uint8_t slot = board->tiles[from.x][from.y];
+    uint8_t colorIndex = entity_getColorIndex(entity->color);
+
+    assert(!board_isOccupied(board, location));
+
+    // Clear the entity's current position
+    unlinkTile(board, from);
+    clearRowBits(board->colors[colorIndex], from.y, 1 << from.x);
+    clearRowBits(board->viruses, from.y, 1 << from.x);
+    board->tiles[from.x][from.y] = BOARD_NO_ENTITY;
+    drMarioDisplay_clearTile(from);
 
     // Move the entity
     entity->location = location;
-    board->tiles[location.x][location.y] = entity;
-    
+    board->tiles[location.x][location.y] = slot;
+    setRowBits(board->colors[colorIndex], location.y, 1 << location.x);
+    if (entity->type == ENTITY_VIRUS)
+        setRowBits(board->viruses, location.y, 1 << location.x);
+
     // Draw the entity if it is a virus (pills are handled elsewhere)
     if (entity->type == ENTITY_VIRUS)
         drMarioDisplay_drawVirus(entity);
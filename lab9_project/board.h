@@ -3,6 +3,7 @@
 
 #include "display.h"
 #include "config.h"
+#include <stdbool.h>
 #include <stdint.h>
 
 // Defining the colors of entities
@@ -11,6 +12,21 @@
 #define ENTITY_COLOR_BLUE DISPLAY_CYAN
 #define ENTITY_COLOR_YELLOW DISPLAY_YELLOW
 #define ENTITY_NUM_COLORS 3
+#define ENTITY_COLORS {ENTITY_COLOR_RED, ENTITY_COLOR_BLUE, ENTITY_COLOR_YELLOW}
+
+// Number of same-colored tiles in a row or column that clear
+#define BOARD_MATCH_LENGTH 4
+
+// Every tile can hold an entity, so the arena never runs out
+#define BOARD_MAX_ENTITIES (CONFIG_BOARD_WIDTH_TILES * CONFIG_BOARD_HEIGHT_TILES)
+
+// Value of board_t.tiles for a tile with nothing in it
+#define BOARD_NO_ENTITY 0xFF
+
+// Bitmaps pack 8 rows into each 64-bit word: row y is byte (y % 8) of word
+// (y / 8), and bit x of that byte is column x
+#define BOARD_ROWS_PER_WORD 8
+#define BOARD_WORDS ((CONFIG_BOARD_HEIGHT_TILES + BOARD_ROWS_PER_WORD - 1) / BOARD_ROWS_PER_WORD)
 
 // Defining three types of objects that will occupy tiles
 typedef enum {
@@ -32,9 +48,23 @@ typedef struct entity_t {
     uint16_t color;
 } entity_t;
 
-// Struct containing the current board state
+// One bit per tile, see BOARD_ROWS_PER_WORD for the layout
+typedef uint64_t board_bitmap_t[BOARD_WORDS];
+
+// Struct containing the current board state. The bitmaps say what is where,
+// and are all the match finder and gravity look at. The entities themselves
+// live in a fixed arena inside the board, and tiles maps each tile to its
+// entity's arena slot.
 typedef struct {
-    entity_t *tiles[CONFIG_BOARD_WIDTH_TILES][CONFIG_BOARD_HEIGHT_TILES];
+    board_bitmap_t colors[ENTITY_NUM_COLORS]; // Tiles holding each color
+    board_bitmap_t viruses;     // Tiles holding a virus
+    board_bitmap_t linkedRight; // Pill halves joined to the half to their right
+    board_bitmap_t linkedDown;  // Pill halves joined to the half below them
+
+    entity_t entities[BOARD_MAX_ENTITIES];   // Entity arena
+    uint8_t freeSlots[BOARD_MAX_ENTITIES];   // Unused arena slots (a stack)
+    uint8_t freeCount;                       // Number of unused arena slots
+    uint8_t tiles[CONFIG_BOARD_WIDTH_TILES][CONFIG_BOARD_HEIGHT_TILES];
 } board_t;
 
 // Initializes the board with empty tiles
@@ -43,16 +73,52 @@ void board_initEmpty(board_t *board);
 // Initializes the board with the specified number of viruses
 void board_initViruses(board_t *board, uint8_t numViruses);
 
-// Creates an empty tile at this location
+// Returns the entity at this location, or NULL if the tile is empty
+entity_t *board_getEntity(board_t *board, location_t location);
+
+// Returns true if something occupies this location
+bool board_isOccupied(board_t *board, location_t location);
+
+// Returns one of the entity colors at random
+uint16_t board_getRandomColor();
+
+// Places a new entity on an empty tile and returns it
+entity_t *board_addEntity(board_t *board, entity_type_t type, location_t location, uint16_t color);
+
+// Joins two pill halves on neighboring tiles so gravity moves them together.
+// Call this once a pill has landed.
+void board_linkPillHalves(board_t *board, entity_t *half1, entity_t *half2);
+
+// Finds every run of BOARD_MATCH_LENGTH or more same-colored tiles in a row or
+// column. Sets the matched tiles in matches and returns true if there are any.
+bool board_findMatches(board_t *board, board_bitmap_t matches);
+
+// Removes every entity in matches and erases its tile. A pill half whose
+// partner is removed is left on its own. Returns the number of viruses removed.
+uint8_t board_clearMatches(board_t *board, board_bitmap_t matches);
+
+// Drops every unsupported pill half (or joined pair of halves) by one tile.
+// Viruses never fall. Returns true if anything moved.
+bool board_applyGravity(board_t *board);
+
+// Clears matches and lets everything fall, over and over, until the board is
+// stable. Returns the number of viruses removed.
+uint8_t board_resolve(board_t *board);
+
+// Removes whatever is at this location, leaving an empty tile
 void entity_initEmpty(board_t *board, location_t location);
 
 // Creates a virus at this location with the given color
 void entity_initVirus(board_t *board, location_t location, uint16_t color);
 
-// Randomizes the given entity's color
+// Returns the position of a color in ENTITY_COLORS
+uint8_t entity_getColorIndex(uint16_t color);
+
+// Randomizes the given entity's color. Call this before the entity is placed.
 void entity_randomizeColor(entity_t *entity);
 
-// Moves the entity to the given location
+// Moves the entity to the given empty location. A pill half is unlinked from
+// its partner; call board_linkPillHalves() again once the pill has landed.
 void entity_move(board_t *board, entity_t *entity, location_t location);
 
 #endif /* BOARD_H */
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 // Timing details
 #define CONFIG_GAME_TIMER_PERIOD 45.0E-3
+#define CONFIG_INPUT_TIMER_PERIOD 10.0E-3
+#define CONFIG_TIMER_WHEEL_TICK_PERIOD 5.0E-3
 
 // Board parameters
 #define CONFIG_BOARD_WIDTH_TILES 8
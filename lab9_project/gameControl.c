@@ -1,7 +1,7 @@
 #include "graphics.h"
 #include "pill.h"
 #include "board.h"
-#include "buttons.h"
+#include "input.h"
 
 // Game control states
 typedef enum {
@@ -18,10 +18,11 @@ static pill_t pill;    // TODO: make this an array after testing
 
 // Initialize the game control logic
 void gameControl_init() {
-    buttons_init();
+    input_init(CONFIG_INPUT_TIMER_PERIOD);
     drMarioDisplay_init();
     board_initViruses(&board, CONFIG_NUM_VIRUSES);
     pill_initTop(&pill, &board);
+    drMarioDisplay_flush();
     // printf("Pill location = (%d, %d)\n", pill.pill_half_1->location.x, pill.pill_half_1->location.y);
     // pill_move(&pill, &board, MOVE_DOWN);
     // printf("Pill location = (%d, %d)\n", pill.pill_half_1->location.x, pill.pill_half_1->location.y);
@@ -49,10 +50,44 @@ void gameControl_init() {
     pill_test(&pill);
 }
 
+// Move the pill for every button press (and repeat, while a button is held)
+// since the last tick
+static void handleInput() {
+    input_event_t event;
+    while (input_getEvent(&event)) {
+        if (event.type != INPUT_EVENT_PRESS && event.type != INPUT_EVENT_REPEAT)
+            continue;
+
+        switch (event.input) {
+        case INPUT_BTN3:
+            pill_move(&pill, &board, MOVE_LEFT);
+            break;
+        case INPUT_BTN2:
+            pill_move(&pill, &board, MOVE_DOWN);
+            break;
+        case INPUT_BTN1:
+            pill_move(&pill, &board, ROTATE_CLOCKWISE);
+            break;
+        case INPUT_BTN0:
+            pill_move(&pill, &board, MOVE_RIGHT);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
 // Tick the game control logic
 void gameControl_tick() {
+    handleInput();
+
     // // Game state machine
     // switch (currState) {
 
     // }
+
+    // Draw whatever changed this tick. Moves, gravity and clears
+    // (board_resolve()) only mark tiles dirty, so this stays the last step of
+    // the tick, after all of them.
+    drMarioDisplay_flush();
 }
\ No newline at end of file
@@ -1,9 +1,81 @@
 #include "display.h"
 #include "config.h"
 #include "board.h"
+#include "graphics.h"
 #include "pill.h"
+#include "sprite.h"
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
+
+// Sprite numbers: the empty tile, then a virus of each color, then every pill
+// half shape of each color
+#define SPRITE_EMPTY 0
+#define SPRITE_VIRUS(colorIndex) (1 + (colorIndex))
+#define SPRITE_PILL_HALF(colorIndex, shape) (1 + ENTITY_NUM_COLORS + (colorIndex) * DRMARIODISPLAY_HALF_SHAPES + (shape))
+#define SPRITE_COUNT (1 + ENTITY_NUM_COLORS * (1 + DRMARIODISPLAY_HALF_SHAPES))
+
+// Virus sprite bitmap
+static const uint8_t virus_bitmap[] = {
+    0xc0, 0x30, 0x80, 0x10, 0x00, 0x00, 0x09, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x00, 
+    0x10, 0x80, 0x00, 0x00, 0x80, 0x10, 0xc0, 0x30,
+};
+
+// Horizontal pill bitmap, two tiles and the line between them
+static const uint8_t pillHorizontal_bitmap[] = {
+    0xc0, 0x00, 0x01, 0x80, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0xc0, 0x00, 0x01, 0x80
+};
+
+// Vertical pill bitmap, two tiles and the line between them
+static const uint8_t pillVertical_bitmap[] = {
+    0xc0, 0x30, 0x80, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x10, 
+    0xc0, 0x30
+};
+
+// Half pill bitmap
+static const uint8_t pillSingle_bitmap[] = {
+    0xc0, 0x30, 0x80, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x80, 0x10, 0xc0, 0x30, 
+};
+
+static const uint16_t colors[ENTITY_NUM_COLORS] = ENTITY_COLORS;
+
+// Every tile image, rendered once at init
+static sprite_t sprites[SPRITE_COUNT];
+
+// Sprite on the screen and sprite wanted for each tile, and the tiles whose
+// wanted sprite was set since the last flush
+static uint8_t shownSprites[CONFIG_BOARD_WIDTH_TILES][CONFIG_BOARD_HEIGHT_TILES];
+static uint8_t wantedSprites[CONFIG_BOARD_WIDTH_TILES][CONFIG_BOARD_HEIGHT_TILES];
+static board_bitmap_t dirtyTiles;
+
+// Renders every sprite
+static void renderSprites() {
+    uint16_t background = CONFIG_BACKGROUND_COLOR;
+
+    sprite_render(&sprites[SPRITE_EMPTY], NULL, 0, 0, 0, background, background);
+
+    for (uint8_t c = 0; c < ENTITY_NUM_COLORS; c++) {
+        sprite_render(&sprites[SPRITE_VIRUS(c)], virus_bitmap, SPRITE_WIDTH, 0, 0, colors[c], background);
+
+        // Each half of a pill is cut out of the two-tile bitmap
+        sprite_render(&sprites[SPRITE_PILL_HALF(c, DRMARIODISPLAY_HALF_SINGLE)], pillSingle_bitmap, SPRITE_WIDTH, 0, 0, colors[c], background);
+        sprite_render(&sprites[SPRITE_PILL_HALF(c, DRMARIODISPLAY_HALF_LEFT)], pillHorizontal_bitmap, 2 * CONFIG_TILE_WIDTH - 1, 0, 0, colors[c], background);
+        sprite_render(&sprites[SPRITE_PILL_HALF(c, DRMARIODISPLAY_HALF_RIGHT)], pillHorizontal_bitmap, 2 * CONFIG_TILE_WIDTH - 1, CONFIG_TILE_WIDTH, 0, colors[c], background);
+        sprite_render(&sprites[SPRITE_PILL_HALF(c, DRMARIODISPLAY_HALF_TOP)], pillVertical_bitmap, SPRITE_WIDTH, 0, 0, colors[c], background);
+        sprite_render(&sprites[SPRITE_PILL_HALF(c, DRMARIODISPLAY_HALF_BOTTOM)], pillVertical_bitmap, SPRITE_WIDTH, 0, CONFIG_TILE_HEIGHT, colors[c], background);
+    }
+}
+
+// Asks for a sprite on a tile at the next flush
+static void setTile(location_t location, uint8_t sprite) {
+    wantedSprites[location.x][location.y] = sprite;
+    dirtyTiles[location.y / BOARD_ROWS_PER_WORD] |= 1ULL << (location.y % BOARD_ROWS_PER_WORD * 8 + location.x);
+}
 
 // Initialize display and draw the board
 void drMarioDisplay_init() {
@@ -30,107 +102,70 @@ void drMarioDisplay_init() {
         display_drawFastVLine(lineStartX, lineStartY, board_height+1, CONFIG_BOARD_LINE_COLOR);
         lineStartX += CONFIG_TILE_WIDTH;
     }
-}
 
-// Fills the tile at a location with the given color
-void fillTile(location_t location, uint16_t color) {
-    int16_t cornerX = CONFIG_BOARD_TOP_LEFT_X + location.x * CONFIG_TILE_WIDTH + 1;
-    int16_t cornerY = CONFIG_BOARD_TOP_LEFT_Y + location.y * CONFIG_TILE_HEIGHT + 1;
-    int16_t width = CONFIG_TILE_WIDTH - 1;
-    int16_t height = CONFIG_TILE_HEIGHT - 1;
-
-    display_fillRect(cornerX, cornerY, width, height, color);
+    // Every tile starts out empty on the screen
+    renderSprites();
+    memset(shownSprites, SPRITE_EMPTY, sizeof(shownSprites));
+    memset(wantedSprites, SPRITE_EMPTY, sizeof(wantedSprites));
+    memset(dirtyTiles, 0, sizeof(dirtyTiles));
 }
 
 // Erases the current tile
 void drMarioDisplay_clearTile(location_t location) {
-    fillTile(location, CONFIG_BACKGROUND_COLOR);
+    setTile(location, SPRITE_EMPTY);
 }
 
 // Draws the given virus
 void drMarioDisplay_drawVirus(entity_t *virus) {
-    int16_t cornerX = CONFIG_BOARD_TOP_LEFT_X + virus->location.x * CONFIG_TILE_WIDTH + 1;
-    int16_t cornerY = CONFIG_BOARD_TOP_LEFT_Y + virus->location.y * CONFIG_TILE_HEIGHT + 1;
-    uint16_t width = CONFIG_TILE_WIDTH - 1;
-    uint16_t height = CONFIG_TILE_HEIGHT - 1;
-    uint16_t color = CONFIG_BACKGROUND_COLOR;
-
-    // Virus sprite bitmap
-    const uint8_t virus_bitmap[] = {
-        0xc0, 0x30, 0x80, 0x10, 0x00, 0x00, 0x09, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x00, 
-        0x10, 0x80, 0x00, 0x00, 0x80, 0x10, 0xc0, 0x30,
-    };
-
-    fillTile(virus->location, virus->color);
-    display_drawBitmap(cornerX, cornerY, virus_bitmap, width, height, color);
+    setTile(virus->location, SPRITE_VIRUS(entity_getColorIndex(virus->color)));
 }
 
 // Draws the given pill
 void drMarioDisplay_drawPill(pill_t *pill) {
-    uint16_t cornerX = CONFIG_BOARD_TOP_LEFT_X + pill->pill_half_1->location.x * CONFIG_TILE_WIDTH + 1;
-    uint16_t cornerY = CONFIG_BOARD_TOP_LEFT_Y + pill->pill_half_1->location.y * CONFIG_TILE_HEIGHT + 1;
-    uint16_t width;
-    uint16_t height;
-    uint16_t color = CONFIG_BACKGROUND_COLOR;
-
-    // Horizontal pill bitmap
-    const uint8_t pillHorizontal_bitmap[] = {
-        0xc0, 0x00, 0x01, 0x80, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0xc0, 0x00, 0x01, 0x80
-    };
-
-    // Vertical pill bitmap
-    const uint8_t pillVertical_bitmap[] = {
-        0xc0, 0x30, 0x80, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x10, 
-        0xc0, 0x30
-    };
-
-    // Half pill bitmap
-    const uint8_t pillSingle_bitmap[] = {
-        0xc0, 0x30, 0x80, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-        0x00, 0x00, 0x00, 0x00, 0x80, 0x10, 0xc0, 0x30, 
-    };
-
     // Draw differently based on the orientation
     switch (pill->orientation) {
         case ORIENTATION_EMPTY:
             printf("WARNING: Trying to print an empty pill");
             break;
         case ORIENTATION_HORIZONTAL:
-            // Fill in the tiles
-            fillTile(pill->pill_half_1->location, pill->pill_half_1->color);
-            fillTile(pill->pill_half_2->location, pill->pill_half_2->color);
-
-            width = CONFIG_TILE_WIDTH * 2 - 1;
-            height = CONFIG_TILE_HEIGHT - 1;
-
-            // Draw in the overlay to round out the corners
-            display_drawBitmap(cornerX, cornerY, pillHorizontal_bitmap, width, height, color);
-
+            drMarioDisplay_drawPillHalf(pill->pill_half_1, DRMARIODISPLAY_HALF_LEFT);
+            drMarioDisplay_drawPillHalf(pill->pill_half_2, DRMARIODISPLAY_HALF_RIGHT);
             break;
         case ORIENTATION_VERTICAL:
-            fillTile(pill->pill_half_1->location, pill->pill_half_1->color);
-            fillTile(pill->pill_half_2->location, pill->pill_half_2->color);
-
-            width = CONFIG_TILE_WIDTH - 1;
-            height = CONFIG_TILE_HEIGHT * 2 - 1;
-
-            // Draw in the overlay to round out the corners
-            display_drawBitmap(cornerX, cornerY, pillVertical_bitmap, width, height, color);
-
+            drMarioDisplay_drawPillHalf(pill->pill_half_1, DRMARIODISPLAY_HALF_TOP);
+            drMarioDisplay_drawPillHalf(pill->pill_half_2, DRMARIODISPLAY_HALF_BOTTOM);
             break;
         case ORIENTATION_SINGLE:
-            fillTile(pill->pill_half_1->location, pill->pill_half_1->color);
-
-            width = CONFIG_TILE_WIDTH - 1;
-            height = CONFIG_TILE_HEIGHT - 1;
+            drMarioDisplay_drawPillHalf(pill->pill_half_1, DRMARIODISPLAY_HALF_SINGLE);
+            break;
+    }
+}
 
-            // Draw in the overlay to round out the corners
-            display_drawBitmap(cornerX, cornerY, pillSingle_bitmap, width, height, color);
+// Draws one pill half
+void drMarioDisplay_drawPillHalf(entity_t *half, drMarioDisplay_halfShape_t shape) {
+    setTile(half->location, SPRITE_PILL_HALF(entity_getColorIndex(half->color), shape));
+}
 
-            break;
+// Draws every tile that changed since the last flush
+void drMarioDisplay_flush() {
+    location_t location;
+
+    for (uint8_t i = 0; i < BOARD_WORDS; i++) {
+        for (uint64_t left = dirtyTiles[i]; left; left &= left - 1) {
+            uint8_t bit = __builtin_ctzll(left);
+            location.x = bit % 8;
+            location.y = i * BOARD_ROWS_PER_WORD + bit / 8;
+
+            // A tile that changed and changed back needs no drawing
+            uint8_t sprite = wantedSprites[location.x][location.y];
+            if (sprite == shownSprites[location.x][location.y])
+                continue;
+
+            int16_t cornerX = CONFIG_BOARD_TOP_LEFT_X + location.x * CONFIG_TILE_WIDTH + 1;
+            int16_t cornerY = CONFIG_BOARD_TOP_LEFT_Y + location.y * CONFIG_TILE_HEIGHT + 1;
+            sprite_draw(&sprites[sprite], cornerX, cornerY);
+            shownSprites[location.x][location.y] = sprite;
+        }
+        dirtyTiles[i] = 0;
     }
-}
\ No newline at end of file
+}
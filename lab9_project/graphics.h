@@ -5,6 +5,20 @@
 #include "pill.h"
 #include <stdbool.h>
 
+// Which part of a pill a pill half is drawn as
+typedef enum {
+    DRMARIODISPLAY_HALF_SINGLE, // A half on its own
+    DRMARIODISPLAY_HALF_LEFT,   // Left half of a pill lying on its side
+    DRMARIODISPLAY_HALF_RIGHT,
+    DRMARIODISPLAY_HALF_TOP,    // Top half of a pill standing up
+    DRMARIODISPLAY_HALF_BOTTOM,
+    DRMARIODISPLAY_HALF_SHAPES
+} drMarioDisplay_halfShape_t;
+
+// Every tile image is pre-rendered at init. The draw functions below only
+// record what each tile should show; drMarioDisplay_flush() then redraws the
+// tiles that actually changed, once each.
+
 // Initialize display and draw the board
 void drMarioDisplay_init();
 
@@ -17,4 +31,10 @@ void drMarioDisplay_drawVirus(entity_t *virus);
 // Draws the given pill
 void drMarioDisplay_drawPill(pill_t *pill);
 
-#endif /* GRAPHICS_H */
\ No newline at end of file
+// Draws one pill half in the given shape
+void drMarioDisplay_drawPillHalf(entity_t *half, drMarioDisplay_halfShape_t shape);
+
+// Draws every tile that changed since the last flush
+void drMarioDisplay_flush();
+
+#endif /* GRAPHICS_H */
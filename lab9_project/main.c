@@ -1,30 +1,47 @@
+#include <stdbool.h>
+
 #include "config.h"
 #include "gameControl.h"
 
 #include "intervalTimer.h"
 #include "interrupts.h"
-#include "buttons.h"
+#include "idle.h"
+#include "input.h"
+#include "timerWheel.h"
+
+// The game and the input layer both run off interval timer 0
+static timerWheel_timer_t gameTimer;
+static timerWheel_timer_t inputTimer;
 
-// Interrupt service routine to update game state
+// Raised by the game timer, cleared by the main loop when it runs the tick
+static volatile bool gameTickPending = false;
+
+// Timer callback: the game tick draws to the display, so it runs in the main
+// loop rather than in the interrupt
 void game_isr() {
-  intervalTimer_ackInterrupt(INTERVAL_TIMER_0);
-  // gameControl_tick();
+    gameTickPending = true;
 }
 
+// True once the game timer has raised the flag
+static bool gameTickRaised() { return gameTickPending; }
+
 // Initialize drivers and the game control, run the game
 int main() {
     gameControl_init();
 
     // Initialize timer interrupts
     interrupts_init();
-    interrupts_register(INTERVAL_TIMER_0_INTERRUPT_IRQ, game_isr);
+    interrupts_register(INTERVAL_TIMER_0_INTERRUPT_IRQ, timerWheel_isr);
     interrupts_irq_enable(INTERVAL_TIMER_0_INTERRUPT_IRQ);
 
-    intervalTimer_initCountDown(INTERVAL_TIMER_0, CONFIG_GAME_TIMER_PERIOD);
-    intervalTimer_enableInterrupt(INTERVAL_TIMER_0);
-    intervalTimer_start(INTERVAL_TIMER_0);
+    timerWheel_init(INTERVAL_TIMER_0, CONFIG_TIMER_WHEEL_TICK_PERIOD);
+    timerWheel_startPeriodic(&inputTimer, CONFIG_INPUT_TIMER_PERIOD, input_tick);
+    timerWheel_startPeriodic(&gameTimer, CONFIG_GAME_TIMER_PERIOD, game_isr);
 
-    // Main game loop
-    while(1)
-        ;
+    // Main game loop: sleep until the game timer goes off, then tick the game
+    while(1) {
+        idle_waitUntil(gameTickRaised);
+        gameTickPending = false;
+        gameControl_tick();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "board.h"
+#include "config.h"
+#include "graphics.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef HEADLESS
+#include "headless.h"
+#include <time.h>
+#else
+#include "intervalTimer.h"
+
+// Free-running timer used as a clock
+#define BENCH_TIMER INTERVAL_TIMER_0
+#endif
+
+// Number of random full boards resolved
+#define BENCH_BOARDS 2000
+
+// One in this many tiles holds a virus, the rest are pill halves
+#define BENCH_VIRUS_ODDS 4
+
+static board_t board;
+
+// Return the time in seconds since an arbitrary start
+static double now() {
+#ifdef HEADLESS
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+    return intervalTimer_getTotalDurationInSeconds(BENCH_TIMER);
+#endif
+}
+
+// Fill every tile with a random virus or pill half, and join some neighboring
+// halves into pills lying on their side or standing up
+static void fillBoard() {
+    bool linked[CONFIG_BOARD_WIDTH_TILES][CONFIG_BOARD_HEIGHT_TILES] = {{false}};
+    location_t location;
+
+    board_initEmpty(&board);
+    for (location.y = 0; location.y < CONFIG_BOARD_HEIGHT_TILES; location.y++) {
+        for (location.x = 0; location.x < CONFIG_BOARD_WIDTH_TILES; location.x++) {
+            entity_type_t type = rand() % BENCH_VIRUS_ODDS ? ENTITY_PILL_HALF : ENTITY_VIRUS;
+            board_addEntity(&board, type, location, board_getRandomColor());
+        }
+    }
+
+    for (location.y = 0; location.y < CONFIG_BOARD_HEIGHT_TILES; location.y++) {
+        for (location.x = 0; location.x + 1 < CONFIG_BOARD_WIDTH_TILES; location.x += 2) {
+            entity_t *left = board_getEntity(&board, location);
+            entity_t *right = board_getEntity(&board, (location_t){location.x + 1, location.y});
+            if (rand() % 2 && left->type == ENTITY_PILL_HALF && right->type == ENTITY_PILL_HALF) {
+                board_linkPillHalves(&board, left, right);
+                linked[location.x][location.y] = linked[location.x + 1][location.y] = true;
+            }
+        }
+    }
+
+    for (location.y = 0; location.y + 1 < CONFIG_BOARD_HEIGHT_TILES; location.y += 2) {
+        for (location.x = 0; location.x < CONFIG_BOARD_WIDTH_TILES; location.x++) {
+            entity_t *top = board_getEntity(&board, location);
+            entity_t *bottom = board_getEntity(&board, (location_t){location.x, location.y + 1});
+            if (rand() % 2 && top->type == ENTITY_PILL_HALF && bottom->type == ENTITY_PILL_HALF && !linked[location.x][location.y] && !linked[location.x][location.y + 1])
+                board_linkPillHalves(&board, top, bottom);
+        }
+    }
+}
+
+// Returns true if the tile holds an entity of the given color
+static bool hasColor(location_t location, uint16_t color) {
+    entity_t *entity = board_getEntity(&board, location);
+    return entity != NULL && entity->color == color;
+}
+
+// Finds matches one tile at a time through the entities, as a reference for
+// board_findMatches()
+static void findMatchesSlowly(board_bitmap_t matches) {
+    location_t location;
+
+    for (uint8_t i = 0; i < BOARD_WORDS; i++)
+        matches[i] = 0;
+
+    for (location.y = 0; location.y < CONFIG_BOARD_HEIGHT_TILES; location.y++) {
+        for (location.x = 0; location.x < CONFIG_BOARD_WIDTH_TILES; location.x++) {
+            entity_t *entity = board_getEntity(&board, location);
+            if (entity == NULL)
+                continue;
+
+            // Look for a run going right and a run going down from this tile
+            for (uint8_t direction = 0; direction < 2; direction++) {
+                uint8_t length = 1;
+                location_t next = location;
+                while (true) {
+                    next.x += direction == 0;
+                    next.y += direction == 1;
+                    if (next.x >= CONFIG_BOARD_WIDTH_TILES || next.y >= CONFIG_BOARD_HEIGHT_TILES || !hasColor(next, entity->color))
+                        break;
+                    length++;
+                }
+                if (length < BOARD_MATCH_LENGTH)
+                    continue;
+
+                next = location;
+                for (uint8_t k = 0; k < length; k++) {
+                    matches[next.y / BOARD_ROWS_PER_WORD] |= 1ULL << (next.y % BOARD_ROWS_PER_WORD * 8 + next.x);
+                    next.x += direction == 0;
+                    next.y += direction == 1;
+                }
+            }
+        }
+    }
+}
+
+// Returns true if the tile is linked to the tile on its right
+static bool isLinkedRight(location_t location) {
+    return board.linkedRight[location.y / BOARD_ROWS_PER_WORD] >> (location.y % BOARD_ROWS_PER_WORD * 8 + location.x) & 1;
+}
+
+// Returns true if the tile below this one is occupied
+static bool isSupported(location_t location) {
+    return location.y + 1 >= CONFIG_BOARD_HEIGHT_TILES || board_isOccupied(&board, (location_t){location.x, location.y + 1});
+}
+
+// Returns true if the board's bitmaps and arena agree with each other, and no
+// pill half is left hanging (a pill lying on its side only needs one half
+// supported)
+static bool isSettled() {
+    board_bitmap_t matches;
+    location_t location;
+
+    if (board_findMatches(&board, matches))
+        return false;
+
+    for (location.y = 0; location.y + 1 < CONFIG_BOARD_HEIGHT_TILES; location.y++) {
+        for (location.x = 0; location.x < CONFIG_BOARD_WIDTH_TILES; location.x++) {
+            entity_t *entity = board_getEntity(&board, location);
+            if (entity == NULL)
+                continue;
+            if (entity->location.x != location.x || entity->location.y != location.y)
+                return false;
+            if (entity->type != ENTITY_PILL_HALF || isSupported(location))
+                continue;
+            location_t left = {location.x - 1, location.y};
+            location_t right = {location.x + 1, location.y};
+            if (location.x > 0 && isLinkedRight(left) && isSupported(left))
+                continue;
+            if (isLinkedRight(location) && isSupported(right))
+                continue;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Check board_findMatches() against the slow version on random boards
+static bool checkMatches() {
+    board_bitmap_t fast;
+    board_bitmap_t slow;
+
+    srand(0);
+    for (uint16_t i = 0; i < BENCH_BOARDS; i++) {
+        fillBoard();
+        board_findMatches(&board, fast);
+        findMatchesSlowly(slow);
+        for (uint8_t w = 0; w < BOARD_WORDS; w++) {
+            if (fast[w] != slow[w])
+                return false;
+        }
+    }
+    return true;
+}
+
+// Put every tile of the board on the screen
+static void drawBoard() {
+    location_t location;
+
+    for (location.y = 0; location.y < CONFIG_BOARD_HEIGHT_TILES; location.y++) {
+        for (location.x = 0; location.x < CONFIG_BOARD_WIDTH_TILES; location.x++) {
+            entity_t *entity = board_getEntity(&board, location);
+            if (entity == NULL)
+                drMarioDisplay_clearTile(location);
+            else if (entity->type == ENTITY_VIRUS)
+                drMarioDisplay_drawVirus(entity);
+            else
+                drMarioDisplay_drawPillHalf(entity, DRMARIODISPLAY_HALF_SINGLE);
+        }
+    }
+    drMarioDisplay_flush();
+}
+
+// Time finding matches, resolving whole cascades, and redrawing what the
+// cascade changed, on random full boards
+static void runBench() {
+    board_bitmap_t matches;
+    double findSeconds = 0.0;
+    double resolveSeconds = 0.0;
+    double flushSeconds = 0.0;
+    uint32_t virusCount = 0;
+#ifdef HEADLESS
+    uint32_t drawCalls = 0;
+#endif
+    bool settled = true;
+
+    drMarioDisplay_init();
+    srand(1);
+    for (uint16_t i = 0; i < BENCH_BOARDS; i++) {
+        fillBoard();
+        drawBoard();
+
+        double start = now();
+        board_findMatches(&board, matches);
+        findSeconds += now() - start;
+
+        start = now();
+        virusCount += board_resolve(&board);
+        resolveSeconds += now() - start;
+
+#ifdef HEADLESS
+        headless_resetDrawCallCount();
+#endif
+        start = now();
+        drMarioDisplay_flush();
+        flushSeconds += now() - start;
+#ifdef HEADLESS
+        drawCalls += headless_getDrawCallCount();
+#endif
+
+        settled = settled && isSettled();
+    }
+
+    printf("board %dx%d, %d boards, %lu viruses cleared\n", CONFIG_BOARD_WIDTH_TILES, CONFIG_BOARD_HEIGHT_TILES, BENCH_BOARDS, (unsigned long)virusCount);
+    printf("find matches %8.3f us/board\n", findSeconds * 1e6 / BENCH_BOARDS);
+    printf("resolve      %8.3f us/board\n", resolveSeconds * 1e6 / BENCH_BOARDS);
+    printf("flush        %8.3f us/board", flushSeconds * 1e6 / BENCH_BOARDS);
+#ifdef HEADLESS
+    printf(", %.1f draw calls/board", (double)drawCalls / BENCH_BOARDS);
+#endif
+    printf("\n");
+    printf("every board settled: %s\n", settled ? "yes" : "NO");
+}
+
+// Check and time the board's match finder and gravity
+int main() {
+#ifndef HEADLESS
+    intervalTimer_initCountUp(BENCH_TIMER);
+    intervalTimer_start(BENCH_TIMER);
+#endif
+
+    printf("match finder agrees with tile scan: %s\n", checkMatches() ? "yes" : "NO");
+    runBench();
+    return 0;
+}
@@ -25,23 +25,14 @@ void pill_initHidden(pill_t *pill) {
 
 // Initializes the given pill at the top of the screen
 void pill_initTop(pill_t *pill, board_t *board) {
+    location_t location = {CONFIG_PILL_START_TILE_X, CONFIG_PILL_START_TILE_Y};
+
     // Generate and place first pill half
-    entity_t pill_half_1;
-    pill->pill_half_1 = &pill_half_1;
-    entity_randomizeColor(pill->pill_half_1);
-    pill->pill_half_1->type = ENTITY_PILL_HALF;
-    pill->pill_half_1->location.x = CONFIG_PILL_START_TILE_X;
-    pill->pill_half_1->location.y = CONFIG_PILL_START_TILE_Y;
-    board->tiles[CONFIG_PILL_START_TILE_X][CONFIG_PILL_START_TILE_Y] = pill->pill_half_1;
+    pill->pill_half_1 = board_addEntity(board, ENTITY_PILL_HALF, location, board_getRandomColor());
 
     // Generate and place second pill half
-    entity_t pill_half_2;
-    pill->pill_half_2 = &pill_half_2;
-    entity_randomizeColor(pill->pill_half_2);
-    pill->pill_half_2->type = ENTITY_PILL_HALF;
-    pill->pill_half_2->location.x = CONFIG_PILL_START_TILE_X + 1;
-    pill->pill_half_2->location.y = CONFIG_PILL_START_TILE_Y;
-    board->tiles[CONFIG_PILL_START_TILE_X+1][CONFIG_PILL_START_TILE_Y] = pill->pill_half_2;
+    location.x++;
+    pill->pill_half_2 = board_addEntity(board, ENTITY_PILL_HALF, location, board_getRandomColor());
 
     pill->orientation = ORIENTATION_HORIZONTAL;
     drMarioDisplay_drawPill(pill);
@@ -68,12 +59,12 @@ bool pill_canMoveDown(pill_t *pill, board_t *board) {
             }
 
             // Check for occupied spaces under first half
-            if (board->tiles[ph_1_x][below_ph_1] != NULL) {
+            if (board_isOccupied(board, (location_t){ph_1_x, below_ph_1})) {
                 return false;
             }
 
             // Check for occupied spaces under second half
-            if (board->tiles[ph_2_x][below_ph_2] != NULL) {
+            if (board_isOccupied(board, (location_t){ph_2_x, below_ph_2})) {
                 return false;
             }
 
@@ -92,7 +83,7 @@ bool pill_canMoveDown(pill_t *pill, board_t *board) {
             }
 
             // Check for occupied spaces under second half
-            if (board->tiles[ph_2_x][below_ph_2] != NULL) {
+            if (board_isOccupied(board, (location_t){ph_2_x, below_ph_2})) {
                 return false;
             }
 
@@ -109,7 +100,7 @@ bool pill_canMoveDown(pill_t *pill, board_t *board) {
             }
 
             // Check for occupied spaces under first half
-            if (board->tiles[ph_1_x][below_ph_1] != NULL) {
+            if (board_isOccupied(board, (location_t){ph_1_x, below_ph_1})) {
                 return false;
             }
 
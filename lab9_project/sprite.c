@@ -0,0 +1,86 @@
+#include "config.h"
+#include "display.h"
+#include "sprite.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Returns true if the mask bit at (x, y) is set
+static bool getMaskBit(const uint8_t *mask, uint8_t maskWidth, uint8_t x, uint8_t y) {
+    uint8_t byteWidth = (maskWidth + 7) / 8;
+    return mask[y * byteWidth + x / 8] & (0x80 >> (x % 8));
+}
+
+// Adds a rectangle to a sprite
+static sprite_rect_t *addRect(sprite_t *sprite, uint8_t x, uint8_t y, uint8_t width, uint16_t color) {
+    if (sprite->rectCount == SPRITE_MAX_RECTS) {
+        printf("sprite_render: more than %d rectangles\n", SPRITE_MAX_RECTS);
+        assert(false);
+    }
+
+    sprite_rect_t *rect = &sprite->rects[sprite->rectCount++];
+    rect->x = x;
+    rect->y = y;
+    rect->width = width;
+    rect->height = 1;
+    rect->color = color;
+    return rect;
+}
+
+// Renders a tile and compiles it into rectangles
+void sprite_render(sprite_t *sprite, const uint8_t *mask, uint8_t maskWidth, uint8_t maskX, uint8_t maskY, uint16_t color, uint16_t maskColor) {
+    uint16_t pixels[SPRITE_HEIGHT][SPRITE_WIDTH];
+    uint16_t maskedCount = 0;
+
+    // Pre-render the tile
+    for (uint8_t y = 0; y < SPRITE_HEIGHT; y++) {
+        for (uint8_t x = 0; x < SPRITE_WIDTH; x++) {
+            bool masked = mask != NULL && getMaskBit(mask, maskWidth, maskX + x, maskY + y);
+            pixels[y][x] = masked ? maskColor : color;
+            maskedCount += masked;
+        }
+    }
+
+    // Fill the tile with whichever color covers more of it
+    uint16_t fillColor = maskedCount * 2 > SPRITE_WIDTH * SPRITE_HEIGHT ? maskColor : color;
+    sprite->rectCount = 0;
+    addRect(sprite, 0, 0, SPRITE_WIDTH, fillColor)->height = SPRITE_HEIGHT;
+
+    // Paint the other pixels as runs along each row. A run that lines up with
+    // one in the row above grows that rectangle instead of starting its own.
+    for (uint8_t y = 0; y < SPRITE_HEIGHT; y++) {
+        uint8_t rowStart = sprite->rectCount;
+        uint8_t x = 0;
+        while (x < SPRITE_WIDTH) {
+            if (pixels[y][x] == fillColor) {
+                x++;
+                continue;
+            }
+
+            uint8_t runStart = x;
+            while (x < SPRITE_WIDTH && pixels[y][x] == pixels[y][runStart])
+                x++;
+
+            sprite_rect_t *above = NULL;
+            for (uint8_t i = 1; i < rowStart; i++) {
+                sprite_rect_t *rect = &sprite->rects[i];
+                if (rect->y + rect->height == y && rect->x == runStart && rect->width == x - runStart && rect->color == pixels[y][runStart])
+                    above = rect;
+            }
+            if (above != NULL)
+                above->height++;
+            else
+                addRect(sprite, runStart, y, x - runStart, pixels[y][runStart]);
+        }
+    }
+}
+
+// Draws a sprite
+void sprite_draw(const sprite_t *sprite, int16_t x, int16_t y) {
+    for (uint8_t i = 0; i < sprite->rectCount; i++) {
+        const sprite_rect_t *rect = &sprite->rects[i];
+        display_fillRect(x + rect->x, y + rect->y, rect->width, rect->height, rect->color);
+    }
+}
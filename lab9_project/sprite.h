@@ -0,0 +1,40 @@
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include <stdint.h>
+
+// Size of a sprite, the inside of one board tile
+#define SPRITE_WIDTH (CONFIG_TILE_WIDTH - 1)
+#define SPRITE_HEIGHT (CONFIG_TILE_HEIGHT - 1)
+
+// Most rectangles a compiled sprite can take
+#define SPRITE_MAX_RECTS 32
+
+// One solid rectangle of a sprite, relative to its top left corner
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+    uint8_t width;
+    uint8_t height;
+    uint16_t color;
+} sprite_rect_t;
+
+// A tile image, pre-rendered once and stored as the few solid rectangles that
+// paint it. The display driver can only fill rectangles, so this is the
+// cheapest way to put a full-color image on the screen: the first rectangle
+// fills the whole tile in its most common color, and the rest paint over it.
+typedef struct {
+    sprite_rect_t rects[SPRITE_MAX_RECTS];
+    uint8_t rectCount;
+} sprite_t;
+
+// Renders a tile filled with color, with maskColor wherever a bit is set in a
+// 1-bit mask (in display_drawBitmap() format, maskWidth pixels wide). The tile
+// is taken from the mask starting at (maskX, maskY), so one tile can be cut
+// out of a larger mask. Pass NULL for a plain tile.
+void sprite_render(sprite_t *sprite, const uint8_t *mask, uint8_t maskWidth, uint8_t maskX, uint8_t maskY, uint16_t color, uint16_t maskColor);
+
+// Draws a sprite with its top left corner at (x, y)
+void sprite_draw(const sprite_t *sprite, int16_t x, int16_t y);
+
+#endif /* SPRITE_H */
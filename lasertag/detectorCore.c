@@ -0,0 +1,211 @@
+#include "detectorCore.h"
+
+#include <stdatomic.h>
+
+#include "detector.h"
+#include "mailbox.h"
+
+// Detector is told interrupts are running when it shares the core with the
+// ADC ISR, so it protects the ADC buffer by disabling them.
+#ifdef DETECTORCORE_AMP
+#define DETECTORCORE_SHARED                                                    \
+  __attribute__((section(DETECTORCORE_SHARED_SECTION)))
+#define SHARES_CORE_WITH_ISR false
+#else
+#define DETECTORCORE_SHARED
+#define SHARES_CORE_WITH_ISR true
+#endif
+
+// Value of shared.ready once the game core has set everything up
+#define READY_MAGIC 0x44455443
+
+typedef enum {
+  COMMAND_IGNORE_ALL_HITS,
+  COMMAND_SET_FUDGE_FACTOR_INDEX
+} command_type_t;
+
+// A command from the game core to the detector core
+typedef struct {
+  command_type_t type;
+  uint32_t value;
+} command_t;
+
+// Everything both cores touch. Each mailbox has one writer on each end.
+static struct {
+  volatile uint32_t ready;
+  volatile uint32_t invocationCount; // Only written by the detector core
+
+  mailbox_t hits;     // Detector core -> game core
+  mailbox_t commands; // Game core -> detector core
+  mailbox_snapshot_t power;
+#ifdef DETECTORCORE_AMP
+  mailbox_t adc; // ADC ISR on the game core -> detector core
+  isr_AdcValue_t adcBuffer[DETECTORCORE_ADC_QUEUE_SIZE];
+  bool ignoredFrequencies[FILTER_FREQUENCY_COUNT];
+#endif
+
+  detectorCore_hit_t hitBuffer[DETECTORCORE_HIT_QUEUE_SIZE];
+  command_t commandBuffer[DETECTORCORE_COMMAND_QUEUE_SIZE];
+  double powerBuffer[FILTER_FREQUENCY_COUNT];
+} shared DETECTORCORE_SHARED;
+
+// Last power snapshot the game core has read
+static uint32_t lastPowerSequence;
+
+////////// Helper Functions //////////
+
+// Apply every command waiting for the detector core
+static void runCommands() {
+  command_t command;
+  while (mailbox_receive(&shared.commands, &command)) {
+    switch (command.type) {
+    case COMMAND_IGNORE_ALL_HITS:
+      detector_ignoreAllHits(command.value);
+      break;
+    case COMMAND_SET_FUDGE_FACTOR_INDEX:
+      detector_setFudgeFactorIndex(command.value);
+      break;
+    }
+  }
+}
+
+// Send a command to the detector core. Commands are rare, so a full mailbox
+// means the detector core has stopped.
+static void sendCommand(command_type_t type, uint32_t value) {
+  command_t command = {.type = type, .value = value};
+  while (!mailbox_send(&shared.commands, &command))
+    detectorCore_poll();
+}
+
+////////// Header Functions //////////
+
+// Initialize the mailboxes and the detector.
+void detectorCore_init(bool ignoredFrequencies[]) {
+  shared.ready = 0;
+  atomic_thread_fence(memory_order_seq_cst);
+
+  shared.invocationCount = 0;
+  mailbox_init(&shared.hits, shared.hitBuffer, DETECTORCORE_HIT_QUEUE_SIZE,
+               sizeof(detectorCore_hit_t));
+  mailbox_init(&shared.commands, shared.commandBuffer,
+               DETECTORCORE_COMMAND_QUEUE_SIZE, sizeof(command_t));
+  mailbox_initSnapshot(&shared.power, shared.powerBuffer,
+                       sizeof(shared.powerBuffer));
+  lastPowerSequence = 0;
+#ifdef DETECTORCORE_AMP
+  mailbox_init(&shared.adc, shared.adcBuffer, DETECTORCORE_ADC_QUEUE_SIZE,
+               sizeof(isr_AdcValue_t));
+  for (uint16_t i = 0; i < FILTER_FREQUENCY_COUNT; i++)
+    shared.ignoredFrequencies[i] = ignoredFrequencies[i];
+#else
+  detector_init(ignoredFrequencies);
+#endif
+
+  // Let the detector core go
+  atomic_thread_fence(memory_order_release);
+  shared.ready = READY_MAGIC;
+}
+
+// Pass an ADC sample to the detector core.
+void detectorCore_addAdcValue(isr_AdcValue_t value) {
+#ifdef DETECTORCORE_AMP
+  // The ISR may run before (or during) detectorCore_init()
+  if (shared.ready == READY_MAGIC)
+    mailbox_send(&shared.adc, &value);
+#endif
+}
+
+// Return the number of ADC samples waiting for the detector.
+uint32_t detectorCore_getAdcBacklog() {
+#ifdef DETECTORCORE_AMP
+  return mailbox_getCount(&shared.adc);
+#else
+  return isr_adcBufferElementCount();
+#endif
+}
+
+// Run the detector once and pass on its results.
+void detectorCore_runOnce() {
+  runCommands();
+  detector(SHARES_CORE_WITH_ISR);
+
+  if (detector_hitDetected()) {
+    detectorCore_hit_t hit = {
+        .frequencyNumber = detector_getFrequencyNumberOfLastHit()};
+    mailbox_send(&shared.hits, &hit);
+    detector_clearHit();
+  }
+
+  uint32_t invocationCount = shared.invocationCount + 1;
+  shared.invocationCount = invocationCount;
+  if (invocationCount % DETECTORCORE_INVOCATIONS_PER_POWER_UPDATE == 0) {
+    double powerValues[FILTER_FREQUENCY_COUNT];
+    filter_getCurrentPowerValues(powerValues);
+    mailbox_publish(&shared.power, powerValues);
+  }
+}
+
+// Run the detector forever on this core.
+void detectorCore_main() {
+  while (shared.ready != READY_MAGIC)
+    ;
+  atomic_thread_fence(memory_order_acquire);
+#ifdef DETECTORCORE_AMP
+  detector_init(shared.ignoredFrequencies);
+#endif
+
+  while (1)
+    detectorCore_runOnce();
+}
+
+// Run the detector here unless it has its own core.
+void detectorCore_poll() {
+#ifndef DETECTORCORE_AMP
+  detectorCore_runOnce();
+#endif
+}
+
+// Get the oldest hit not yet seen.
+bool detectorCore_getHit(detectorCore_hit_t *hit) {
+  return mailbox_receive(&shared.hits, hit);
+}
+
+// Copy the latest power values, if they are new.
+bool detectorCore_getPowerValues(double powerValues[]) {
+  return mailbox_readSnapshot(&shared.power, powerValues, &lastPowerSequence);
+}
+
+// Return the number of times the detector has run.
+uint32_t detectorCore_getInvocationCount() { return shared.invocationCount; }
+
+// Return the number of hits dropped.
+uint32_t detectorCore_getDroppedHitCount() {
+  return mailbox_getDroppedCount(&shared.hits);
+}
+
+// Ask the detector core to ignore all hits.
+void detectorCore_ignoreAllHits(bool flagValue) {
+  sendCommand(COMMAND_IGNORE_ALL_HITS, flagValue);
+}
+
+// Ask the detector core to change its fudge factor.
+void detectorCore_setFudgeFactorIndex(uint32_t factor) {
+  sendCommand(COMMAND_SET_FUDGE_FACTOR_INDEX, factor);
+}
+
+#ifdef DETECTORCORE_DETECTOR_CPU
+////////// ADC Buffer on the Detector Core //////////
+
+// The detector core's program doesn't link isr.c, so the detector drains the
+// shared ADC mailbox through the same functions instead.
+
+// Remove the oldest ADC sample, or return 0 if there is none.
+isr_AdcValue_t isr_removeDataFromAdcBuffer() {
+  isr_AdcValue_t value = 0;
+  mailbox_receive(&shared.adc, &value);
+  return value;
+}
+
+// Return the number of ADC samples waiting.
+uint32_t isr_adcBufferElementCount() { return mailbox_getCount(&shared.adc); }
+#endif
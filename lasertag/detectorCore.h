@@ -0,0 +1,108 @@
+#ifndef DETECTORCORE_H_
+#define DETECTORCORE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "filter.h"
+#include "isr.h"
+
+// The detector (ADC drain, filters, power and hit detection) is the only part
+// of lasertag with a hard real-time rate to keep, and it is the part the game
+// and display work slow down. This module lets it run on its own core: the
+// detector core runs detectorCore_runOnce() in a loop, and the game core only
+// talks to it through lock-free mailboxes (mailbox.h), so neither core ever
+// waits on the other.
+//
+// Define DETECTORCORE_AMP in both programs of a two-core build, and also
+// DETECTORCORE_DETECTOR_CPU in CPU1's program. CPU1's main() then just calls
+// detectorCore_main(), and the shared state is placed in the
+// DETECTORCORE_SHARED_SECTION linker section, which both linker scripts must
+// map to the same non-cached (or OCM) address. The ADC ISR runs on CPU0 and
+// the detector on CPU1, so in that build the ADC samples go through a shared
+// mailbox instead of isr.c's buffer: isr_addDataToAdcBuffer() in CPU0's isr.c
+// must pass each value to detectorCore_addAdcValue(), and CPU1's program,
+// which doesn't link isr.c, gets isr_removeDataFromAdcBuffer() and
+// isr_adcBufferElementCount() from this module.
+//
+// Without DETECTORCORE_AMP, detectorCore_poll() runs the detector on the
+// calling core, through the same mailboxes, so the game code is the same
+// either way.
+
+// Linker section that holds the state shared by both cores in an AMP build.
+#define DETECTORCORE_SHARED_SECTION ".detectorCoreShared"
+
+// Hits that can be waiting for the game core before new ones are dropped.
+#define DETECTORCORE_HIT_QUEUE_SIZE 16
+
+// Commands from the game core that can be waiting for the detector core.
+#define DETECTORCORE_COMMAND_QUEUE_SIZE 8
+
+// ADC samples that can be waiting for the detector core in an AMP build
+// (about 10 ms at the 100 kHz ADC rate).
+#define DETECTORCORE_ADC_QUEUE_SIZE 1024
+
+// The detector core publishes new power values every this many detector runs
+// (about 3 times per second).
+#define DETECTORCORE_INVOCATIONS_PER_POWER_UPDATE 30000
+
+// One hit, sent from the detector core to the game core.
+typedef struct {
+  uint16_t frequencyNumber; // Frequency of the shot that hit
+} detectorCore_hit_t;
+
+// Initialize the mailboxes and the detector. Call this once, on the game core,
+// before the detector core starts running. In an AMP build the detector itself
+// is initialized on the detector core, with a copy of ignoredFrequencies.
+void detectorCore_init(bool ignoredFrequencies[]);
+
+// Pass an ADC sample to the detector core. Only used in an AMP build, where
+// CPU0's isr_addDataToAdcBuffer() must call it. Samples are dropped until
+// detectorCore_init() has run, and while the mailbox is full.
+void detectorCore_addAdcValue(isr_AdcValue_t value);
+
+// Return the number of ADC samples waiting for the detector.
+uint32_t detectorCore_getAdcBacklog();
+
+/*********************** Detector core ***********************/
+
+// Apply any commands from the game core, run the detector once, and send any
+// hit and new power values to the game core.
+void detectorCore_runOnce();
+
+// Entry point of the detector core in an AMP build: waits for
+// detectorCore_init() on the game core, initializes the detector, then runs
+// it forever.
+void detectorCore_main();
+
+/************************* Game core *************************/
+
+// Call this from the game core's main loop. It runs the detector once on this
+// core, unless the detector has a core of its own.
+void detectorCore_poll();
+
+// Get the oldest hit the game core hasn't seen yet. Returns false if there is
+// none.
+bool detectorCore_getHit(detectorCore_hit_t *hit);
+
+// Copy the latest power values (FILTER_FREQUENCY_COUNT of them) into
+// powerValues. Returns false, and leaves powerValues alone, if there are no
+// new values since the last call.
+bool detectorCore_getPowerValues(double powerValues[]);
+
+// Return the number of times the detector has run since init.
+uint32_t detectorCore_getInvocationCount();
+
+// Return the number of hits dropped because the game core didn't collect them
+// in time.
+uint32_t detectorCore_getDroppedHitCount();
+
+// Ask the detector core to ignore (or stop ignoring) all hits, see
+// detector_ignoreAllHits().
+void detectorCore_ignoreAllHits(bool flagValue);
+
+// Ask the detector core to change its fudge factor, see
+// detector_setFudgeFactorIndex().
+void detectorCore_setFudgeFactorIndex(uint32_t factor);
+
+#endif /* DETECTORCORE_H_ */
@@ -0,0 +1,103 @@
+#include "mailbox.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+// The memory barriers make sure the other core sees a message's contents
+// before it sees the index that hands the message over. On the A9 they become
+// dmb instructions.
+
+// Return a pointer to the slot for a message number
+static uint8_t *getSlot(mailbox_t *mailbox, uint32_t index) {
+  return mailbox->buffer +
+         (index & (mailbox->capacity - 1)) * mailbox->messageSize;
+}
+
+// Set up an empty mailbox.
+void mailbox_init(mailbox_t *mailbox, void *buffer, uint32_t capacity,
+                  uint32_t messageSize) {
+  mailbox->buffer = buffer;
+  mailbox->capacity = capacity;
+  mailbox->messageSize = messageSize;
+  mailbox->dropped = 0;
+  mailbox->head = 0;
+  mailbox->tail = 0;
+}
+
+// Copy a message into the mailbox.
+bool mailbox_send(mailbox_t *mailbox, const void *message) {
+  uint32_t head = mailbox->head;
+  if (head - mailbox->tail == mailbox->capacity) {
+    mailbox->dropped++;
+    return false;
+  }
+
+  memcpy(getSlot(mailbox, head), message, mailbox->messageSize);
+  atomic_thread_fence(memory_order_release);
+  mailbox->head = head + 1;
+  return true;
+}
+
+// Copy the oldest message out of the mailbox and remove it.
+bool mailbox_receive(mailbox_t *mailbox, void *message) {
+  uint32_t tail = mailbox->tail;
+  if (mailbox->head == tail)
+    return false;
+
+  atomic_thread_fence(memory_order_acquire);
+  memcpy(message, getSlot(mailbox, tail), mailbox->messageSize);
+
+  // Finish reading the slot before handing it back to the producer
+  atomic_thread_fence(memory_order_release);
+  mailbox->tail = tail + 1;
+  return true;
+}
+
+// Return the number of messages waiting.
+uint32_t mailbox_getCount(mailbox_t *mailbox) {
+  return mailbox->head - mailbox->tail;
+}
+
+// Return the number of messages dropped because the mailbox was full.
+uint32_t mailbox_getDroppedCount(mailbox_t *mailbox) {
+  return mailbox->dropped;
+}
+
+// Set up a snapshot.
+void mailbox_initSnapshot(mailbox_snapshot_t *snapshot, void *buffer,
+                          uint32_t size) {
+  snapshot->buffer = buffer;
+  snapshot->size = size;
+  snapshot->sequence = 0;
+}
+
+// Replace the snapshot's value.
+void mailbox_publish(mailbox_snapshot_t *snapshot, const void *value) {
+  uint32_t sequence = snapshot->sequence;
+
+  snapshot->sequence = sequence + 1;
+  atomic_thread_fence(memory_order_release);
+  memcpy(snapshot->buffer, value, snapshot->size);
+  atomic_thread_fence(memory_order_release);
+  snapshot->sequence = sequence + 2;
+}
+
+// Copy the snapshot's value if it has changed.
+bool mailbox_readSnapshot(mailbox_snapshot_t *snapshot, void *value,
+                          uint32_t *lastSequence) {
+  uint32_t before, after;
+
+  // Read until the value was not being written at the time
+  do {
+    before = snapshot->sequence;
+    if (before == *lastSequence)
+      return false;
+    atomic_thread_fence(memory_order_acquire);
+    memcpy(value, snapshot->buffer, snapshot->size);
+    atomic_thread_fence(memory_order_acquire);
+    after = snapshot->sequence;
+  } while ((before & 1) || before != after);
+
+  *lastSequence = after;
+  return true;
+}
@@ -0,0 +1,80 @@
+#ifndef MAILBOX_H_
+#define MAILBOX_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Size of a cache line on the Cortex-A9. The producer's and consumer's indexes
+// are kept on separate lines so the two cores don't fight over one line.
+#define MAILBOX_CACHE_LINE_BYTES 32
+
+// Lock-free channels between the two cores of an asymmetric (AMP) build,
+// where each core runs its own program and they only share memory.
+//
+// A mailbox_t is a ring of fixed-size messages with exactly one producer
+// (sender) and one consumer (receiver). The producer only ever writes the head
+// index and the consumer only the tail index, so neither core has to lock or
+// disable interrupts. A full mailbox drops new messages and counts them.
+//
+// A mailbox_snapshot_t holds only the latest value of something (power values,
+// statistics). The writer never waits; a reader that catches a write in
+// progress simply reads again.
+//
+// Storage is passed in by the caller, so it can be placed in memory both cores
+// can see (on the Zynq, the OCM or a DDR region both programs' linker scripts
+// leave alone).
+
+typedef struct {
+  uint8_t *buffer;      // capacity * messageSize bytes
+  uint32_t capacity;    // Number of messages (a power of two)
+  uint32_t messageSize; // Bytes per message
+  uint32_t dropped;     // Messages dropped because the mailbox was full
+
+  // Next message to write, only written by the producer
+  volatile uint32_t head __attribute__((aligned(MAILBOX_CACHE_LINE_BYTES)));
+  // Next message to read, only written by the consumer
+  volatile uint32_t tail __attribute__((aligned(MAILBOX_CACHE_LINE_BYTES)));
+} mailbox_t;
+
+typedef struct {
+  uint8_t *buffer; // size bytes
+  uint32_t size;   // Bytes in the value
+  // Incremented before and after each write, so it is odd during a write
+  volatile uint32_t sequence;
+} mailbox_snapshot_t;
+
+// Set up an empty mailbox of capacity messages (a power of two) of
+// messageSize bytes each, stored in buffer (capacity * messageSize bytes).
+void mailbox_init(mailbox_t *mailbox, void *buffer, uint32_t capacity,
+                  uint32_t messageSize);
+
+// Producer only. Copy a message into the mailbox. Returns false, and counts
+// the message as dropped, if the mailbox is full.
+bool mailbox_send(mailbox_t *mailbox, const void *message);
+
+// Consumer only. Copy the oldest message out of the mailbox and remove it.
+// Returns false if the mailbox is empty.
+bool mailbox_receive(mailbox_t *mailbox, void *message);
+
+// Return the number of messages waiting. Either core may call this, the answer
+// may be out of date by the time it is used.
+uint32_t mailbox_getCount(mailbox_t *mailbox);
+
+// Return the number of messages dropped because the mailbox was full.
+uint32_t mailbox_getDroppedCount(mailbox_t *mailbox);
+
+// Set up a snapshot of size bytes stored in buffer. It reads as never written
+// until the first mailbox_publish().
+void mailbox_initSnapshot(mailbox_snapshot_t *snapshot, void *buffer,
+                          uint32_t size);
+
+// Writer only. Replace the snapshot's value.
+void mailbox_publish(mailbox_snapshot_t *snapshot, const void *value);
+
+// Reader only. If the snapshot has been written since *lastSequence, copy the
+// value to value, update *lastSequence and return true. Start *lastSequence at
+// 0 to get the first value published.
+bool mailbox_readSnapshot(mailbox_snapshot_t *snapshot, void *value,
+                          uint32_t *lastSequence);
+
+#endif /* MAILBOX_H_ */
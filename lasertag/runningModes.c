@@ -15,10 +15,12 @@ For questions, contact Brad Hutchings or Jeff Goeders, https://ece.byu.edu/
 
 #include "buttons.h"
 #include "detector.h"
+#include "detectorCore.h"
 #include "display.h"
 #include "filter.h"
 #include "histogram.h"
 #include "hitLedTimer.h"
+#include "idle.h"
 #include "interrupts.h"
 #include "intervalTimer.h"
 #include "isr.h"
@@ -50,9 +52,6 @@ For questions, contact Brad Hutchings or Jeff Goeders, https://ece.byu.edu/
 #define MAIN_CUMULATIVE_TIMER                                                  \
   INTERVAL_TIMER_2 // Used to compute cumulative run-time in main.
 
-#define SYSTEM_TICKS_PER_HISTOGRAM_UPDATE                                      \
-  30000 // Update the histogram about 3 times per second.
-
 #define RUNNING_MODE_WARNING_TEXT_SIZE 2 // Upsize the text for visibility.
 #define RUNNING_MODE_WARNING_TEXT_COLOR DISPLAY_RED // Red for more visibility.
 #define RUNNING_MODE_NORMAL_TEXT_SIZE 1 // Normal size for reporting.
@@ -100,7 +99,7 @@ void runningModes_printRunTimeStatistics() {
   }
   // Print out the number of unprocessed elements in ADC queue.
   display_print("Unprocessed elements in ADC queue:");
-  uint32_t remainingElementCount = isr_adcBufferElementCount();
+  uint32_t remainingElementCount = detectorCore_getAdcBacklog();
   display_printlnDecimalInt(remainingElementCount);
   display_printChar('\n');
   double runningSeconds, isrRunningSeconds, mainLoopRunningSeconds;
@@ -134,6 +133,8 @@ void runningModes_printRunTimeStatistics() {
   display_print(sprintfBuffer);
   display_println("%)");
   display_printChar('\n');
+  // Print the share of the run time spent asleep to the console.
+  idle_printStats();
   uint32_t interruptCount = interrupts_isrInvocationCount();
   // Print out total interrupt count.
   display_print("Total interrupts:            ");
@@ -203,7 +204,7 @@ void runningModes_continuous() {
   printf("Ignoring own frequency.\n");
   ignoredFrequenciesArray[runningModes_getFrequencySetting()] = true;
 #endif
-  detector_init(ignoredFrequenciesArray);
+  detectorCore_init(ignoredFrequenciesArray);
 
   // Prints an error message if an internal failure occurs because the argument
   // = true.
@@ -213,8 +214,6 @@ void runningModes_continuous() {
   interrupts_enableTimerGlobalInts(); // Allows the timer to generate
                                       // interrupts.
   interrupts_startArmPrivateTimer();  // Start the private ARM timer running.
-  uint16_t histogramSystemTicks =
-      0; // Only update the histogram display every so many ticks.
   intervalTimer_reset(
       ISR_CUMULATIVE_TIMER); // Used to measure ISR execution time.
   intervalTimer_reset(
@@ -223,35 +222,34 @@ void runningModes_continuous() {
       MAIN_CUMULATIVE_TIMER); // Used to measure main-loop execution time.
   intervalTimer_start(
       TOTAL_RUNTIME_TIMER);            // Start measuring total execution time.
+  idle_resetStats();                   // Measure time asleep from here too.
   transmitter_setContinuousMode(true); // Run the transmitter continuously.
   interrupts_enableArmInts();  // The ARM will start seeing interrupts after
                                // this.
   transmitter_run();           // Start the transmitter.
-  detectorInvocationCount = 0; // Keep track of detector invocations.
   while (!(buttons_read() &
            BUTTONS_BTN3_MASK)) { // Run until you detect btn3 pressed.
     transmitter_setFrequencyNumber(runningModes_getFrequencySetting());
-    detectorInvocationCount++; // Used for run-time statistics.
-    histogramSystemTicks++;    // Keep track of ticks so you know when to update
-                               // the histogram.
-    // Run filters, compute power, etc.
+    // Run filters, compute power, etc. (unless the detector has its own core).
     intervalTimer_start(MAIN_CUMULATIVE_TIMER); // Measure run-time when you are
                                                 // doing something.
-    detector(INTERRUPTS_CURRENTLY_ENABLED); // Interrupts are currently enabled.
+    detectorCore_poll();
     intervalTimer_stop(MAIN_CUMULATIVE_TIMER);
-    // If enough ticks have transpired, update the histogram.
-    if (histogramSystemTicks >= SYSTEM_TICKS_PER_HISTOGRAM_UPDATE) {
-      double powerValues[FILTER_FREQUENCY_COUNT]; // Copy the current power
-                                                  // values to here.
-      filter_getCurrentPowerValues(
-          powerValues); // Copy the current power values.
+    // The detector core publishes new power values every so many runs.
+    double powerValues[FILTER_FREQUENCY_COUNT]; // Copy the current power
+                                                // values to here.
+    if (detectorCore_getPowerValues(powerValues))
       histogram_plotUserFrequencyPower(
           powerValues); // Plot the power values on the TFT.
-      histogramSystemTicks =
-          0; // Reset the tick count and wait for the next update time.
-    }
+#ifdef DETECTORCORE_AMP
+    // The detector runs on the other core, so sleep until the next ADC
+    // interrupt instead of asking it for results again straight away.
+    idle_wait();
+#endif
   }
-  interrupts_disableArmInts();           // Stop interrupts.
+  interrupts_disableArmInts(); // Stop interrupts.
+  detectorInvocationCount =
+      detectorCore_getInvocationCount(); // Used for run-time statistics.
   runningModes_printRunTimeStatistics(); // Print the run-time statistics.
 }
 
@@ -270,17 +268,16 @@ void runningModes_shooter() {
   printf("Ignoring own frequency.\n");
   ignoredFrequencies[runningModes_getFrequencySetting()] = true;
 #endif
-  detector_init(ignoredFrequencies);
+  detectorCore_init(ignoredFrequencies);
   uint16_t hitCount = 0;
-  detectorInvocationCount = 0; // Keep track of detector invocations.
+  // Hits arrive from the detector core, so they are counted here.
+  detector_hitCount_t hitCounts[DETECTOR_HIT_ARRAY_SIZE] = {0};
   trigger_enable();         // Makes the trigger state machine responsive to the
                             // trigger.
   interrupts_initAll(true); // Inits all interrupts but does not enable them.
   interrupts_enableTimerGlobalInts(); // Allows the timer to generate
                                       // interrupts.
   interrupts_startArmPrivateTimer();  // Start the private ARM timer running.
-  uint16_t histogramSystemTicks =
-      0; // Only update the histogram display every so many ticks.
   intervalTimer_reset(
       ISR_CUMULATIVE_TIMER); // Used to measure ISR execution time.
   intervalTimer_reset(
@@ -289,6 +286,7 @@ void runningModes_shooter() {
       MAIN_CUMULATIVE_TIMER); // Used to measure main-loop execution time.
   intervalTimer_start(
       TOTAL_RUNTIME_TIMER);   // Start measuring total execution time.
+  idle_resetStats();          // Measure time asleep from here too.
   interrupts_enableArmInts(); // The ARM will start seeing interrupts after
                               // this.
   lockoutTimer_start(); // Ignore erroneous hits at startup (when all power
@@ -300,23 +298,24 @@ void runningModes_shooter() {
                                                 // frequency as required.
     intervalTimer_start(MAIN_CUMULATIVE_TIMER); // Measure run-time when you are
                                                 // doing something.
-    histogramSystemTicks++; // Keep track of ticks so you know when to update
-                            // the histogram.
-    // Run filters, compute power, run hit-detection.
-    detectorInvocationCount++;              // Used for run-time statistics.
-    detector(INTERRUPTS_CURRENTLY_ENABLED); // Interrupts are currently enabled.
-    if (detector_hitDetected()) {           // Hit detected
-      hitCount++;                           // increment the hit count.
-      detector_clearHit();                  // Clear the hit.
-      detector_hitCount_t
-          hitCounts[DETECTOR_HIT_ARRAY_SIZE]; // Store the hit-counts here.
-      detector_getHitCounts(hitCounts);       // Get the current hit counts.
-      histogram_plotUserHits(hitCounts);      // Plot the hit counts on the TFT.
+    // Run filters, compute power, run hit-detection (unless the detector has
+    // its own core).
+    detectorCore_poll();
+    detectorCore_hit_t hit;
+    if (detectorCore_getHit(&hit)) {     // Hit detected
+      hitCount++;                        // increment the hit count.
+      hitCounts[hit.frequencyNumber]++;  // Count the hit.
+      histogram_plotUserHits(hitCounts); // Plot the hit counts on the TFT.
     }
     intervalTimer_stop(
         MAIN_CUMULATIVE_TIMER); // All done with actual processing.
+#ifdef DETECTORCORE_AMP
+    idle_wait(); // Sleep until the next interrupt.
+#endif
   }
   interrupts_disableArmInts(); // Done with loop, disable the interrupts.
+  detectorInvocationCount =
+      detectorCore_getInvocationCount(); // Used for run-time statistics.
   hitLedTimer_turnLedOff();    // Save power :-)
   runningModes_printRunTimeStatistics(); // Print the run-time statistics to the
                                          // TFT.
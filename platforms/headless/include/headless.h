@@ -0,0 +1,88 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Clock of the AXI interval timers, which virtual time is counted in
+#define HEADLESS_CLOCK_FREQ_HZ 100000000
+
+// Virtual timer clock cycles charged for each Xil_In32() or Xil_Out32()
+#define HEADLESS_BUS_ACCESS_CYCLES 10
+
+// The headless platform lets game logic run on a Linux host with no display,
+// touchscreen or board. The display is a null backend that draws nothing but
+// counts draw calls, and touches come from a script instead of a panel.
+//
+// The three AXI interval timers and the AXI interrupt controller are modeled
+// at the register level in virtual time, so the interval timer, interrupts and
+// timer wheel drivers run unchanged. Virtual time only moves forward by events:
+// every register access costs HEADLESS_BUS_ACCESS_CYCLES timer clock cycles,
+// and idle_wait() jumps straight to the next timer expiry. Interrupts are
+// delivered synchronously, in order, as their time comes, so a run is
+// deterministic and goes as fast as the host allows, however fast the timers
+// tick.
+//
+// Register accesses are dispatched by address to a model of each peripheral.
+// Besides the timers and the interrupt controller, the button and switch GPIOs
+// read the inputs set below, and the other peripherals (LEDs, TFT GPIOs, I2S,
+// XADC) read back what was last written. Accesses are counted per register,
+// which shows where a program spends its bus time.
+
+// Queue a touch at (x, y). The touch is reported by the touchscreen driver API
+// as a completed press-and-release, one queued touch per acknowledgement (or
+// as a press event and a release event).
+// Returns false if the queue is full.
+bool headless_scriptTouch(uint16_t x, uint16_t y);
+
+// Drop every queued touch and go back to the idle status.
+void headless_clearTouches();
+
+// Return the number of display draw calls made since the last reset.
+uint32_t headless_getDrawCallCount();
+
+// Reset the display draw call count.
+void headless_resetDrawCallCount();
+
+// Return the virtual time since start, in seconds.
+double headless_getTime();
+
+// Return the virtual time since start, in HEADLESS_CLOCK_FREQ_HZ cycles.
+// Timestamps (timestamp.h) are taken from this, so timing stats measure
+// virtual time: code only takes as long as its register accesses.
+uint64_t headless_getCycles();
+
+// Move virtual time forward by the given number of seconds, delivering every
+// interrupt that comes due on the way.
+void headless_advanceTime(double seconds);
+
+// Move virtual time forward to the next timer expiry and deliver its
+// interrupt. Returns false, leaving the time as it is, if no timer is running.
+bool headless_runToNextEvent();
+
+// Keep virtual time from running ahead of the host clock, so the program runs
+// at board speed (or slower, if the host can't keep up). Off by default.
+void headless_setRealTimePacing(bool paced);
+
+// Print the virtual time simulated and the host time it took, how often each
+// interrupt line fired, and the host time spent in the interrupt handler
+// against the virtual time it had.
+void headless_printTimingReport();
+
+// Set the value read from the push button GPIO.
+void headless_setButtons(uint8_t buttons);
+
+// Set the value read from the slide switch GPIO.
+void headless_setSwitches(uint8_t switches);
+
+// Return the value last written to the LED GPIO.
+uint8_t headless_getLeds();
+
+// Print the read and write counts of every register accessed since the last
+// reset, by peripheral, and of accesses to addresses no peripheral claims.
+void headless_printRegisterProfile();
+
+// Reset every register access count.
+void headless_resetRegisterProfile();
+
+#endif /* HEADLESS_H */
@@ -0,0 +1,181 @@
+#include <string.h>
+
+#include "display.h"
+#include "headless.h"
+
+// Null display backend: every draw call is counted and then dropped. Text
+// state and rotation are kept so the getters behave like the real display.
+
+static uint32_t drawCallCount = 0;
+static uint8_t rotation = 0;
+
+/***********HELPER FUNCTIONS************/
+
+// Count one draw call
+static void countDraw() { drawCallCount++; }
+
+/***********HEADLESS FUNCTIONS************/
+
+// Return the number of display draw calls made since the last reset.
+uint32_t headless_getDrawCallCount() { return drawCallCount; }
+
+// Reset the display draw call count.
+void headless_resetDrawCallCount() { drawCallCount = 0; }
+
+/***********DISPLAY FUNCTIONS************/
+
+void display_init() { rotation = DISPLAY_LANDSCAPE_MODE_ORIGIN_UPPER_LEFT; }
+
+void display_drawPixel(int16_t x0, int16_t y0, uint16_t color) { countDraw(); }
+
+void display_drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                      uint16_t color) {
+  countDraw();
+}
+
+void display_drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  countDraw();
+}
+
+void display_drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  countDraw();
+}
+
+void display_drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                      uint16_t color) {
+  countDraw();
+}
+
+void display_fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                      uint16_t color) {
+  countDraw();
+}
+
+void display_fillScreen(uint16_t color) { countDraw(); }
+
+void display_invertDisplay(bool i) {}
+
+void display_drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  countDraw();
+}
+
+void display_fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  countDraw();
+}
+
+void display_drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                          int16_t x2, int16_t y2, uint16_t color) {
+  countDraw();
+}
+
+void display_fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                          int16_t x2, int16_t y2, uint16_t color) {
+  countDraw();
+}
+
+void display_drawRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
+                           int16_t radius, uint16_t color) {
+  countDraw();
+}
+
+void display_fillRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
+                           int16_t radius, uint16_t color) {
+  countDraw();
+}
+
+void display_drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w,
+                        int16_t h, uint16_t color) {
+  countDraw();
+}
+
+void display_drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                      uint16_t bg, uint8_t size) {
+  countDraw();
+}
+
+void display_setCursor(int16_t x, int16_t y) {}
+
+void display_setTextColor(uint16_t c) {}
+
+void display_setTextColorBg(uint16_t c, uint16_t bg) {}
+
+void display_setTextSize(uint8_t s) {}
+
+void display_setTextWrap(bool w) {}
+
+void display_setRotation(uint8_t r) { rotation = r % 4; }
+
+// Landscape rotations are odd
+int16_t display_height() {
+  return (rotation & 1) ? DISPLAY_HEIGHT : DISPLAY_WIDTH;
+}
+
+int16_t display_width() {
+  return (rotation & 1) ? DISPLAY_WIDTH : DISPLAY_HEIGHT;
+}
+
+uint16_t display_color565(uint8_t r, uint8_t g, uint8_t b) {
+  return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+size_t display_println(const char str[]) {
+  countDraw();
+  return strlen(str) + 1;
+}
+
+size_t display_printlnChar(char c) {
+  countDraw();
+  return 2;
+}
+
+size_t display_printlnDecimalInt(int num) {
+  countDraw();
+  return 1;
+}
+
+size_t display_print(const char str[]) {
+  countDraw();
+  return strlen(str);
+}
+
+size_t display_printChar(char c) {
+  countDraw();
+  return 1;
+}
+
+size_t display_printDecimalInt(int num) {
+  countDraw();
+  return 1;
+}
+
+// The display self tests have nothing to time
+unsigned long display_testLines(uint16_t color) { return 0; }
+unsigned long display_testFastLines(uint16_t color1, uint16_t color2) {
+  return 0;
+}
+unsigned long display_testRects(uint16_t color) { return 0; }
+unsigned long display_testFilledRects(uint16_t color1, uint16_t color2) {
+  return 0;
+}
+unsigned long display_testFilledCircles(uint8_t radius, uint16_t color) {
+  return 0;
+}
+unsigned long display_testCircles(uint8_t radius, uint16_t color) { return 0; }
+unsigned long display_testTriangles() { return 0; }
+unsigned long display_testFilledTriangles() { return 0; }
+unsigned long display_testRoundRects() { return 0; }
+unsigned long display_testFilledRoundRects() { return 0; }
+unsigned long display_testFillScreen() { return 0; }
+unsigned long display_testText() { return 0; }
+unsigned long display_test() { return 0; }
+
+// The panel is never touched, scripted touches bypass it (see scriptedTouch.c)
+bool display_isTouched(void) { return false; }
+
+void display_getTouchedPoint(int16_t *x, int16_t *y, uint8_t *z) {
+  *x = 0;
+  *y = 0;
+  *z = 0;
+}
+
+void display_clearOldTouchData() {}
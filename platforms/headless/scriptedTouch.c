@@ -0,0 +1,77 @@
+#include "headless.h"
+#include "touchscreen.h"
+
+// Most touches that can be queued at once
+#define MAX_QUEUED_TOUCHES 64
+
+// Scripted replacement for the touchscreen driver. Each queued touch shows up
+// as TOUCHSCREEN_RELEASED until it is acknowledged, or as a press event
+// followed by a release event; there is no pressed phase or debouncing.
+static display_point_t touches[MAX_QUEUED_TOUCHES];
+static uint16_t head = 0;  // Next touch to report
+static uint16_t count = 0; // Number of queued touches
+
+// True once the press event of the touch at head has been taken
+static bool pressReported = false;
+
+/***********HEADLESS FUNCTIONS************/
+
+// Queue a touch at (x, y).
+bool headless_scriptTouch(uint16_t x, uint16_t y) {
+  if (count == MAX_QUEUED_TOUCHES)
+    return false;
+
+  uint16_t tail = (head + count) % MAX_QUEUED_TOUCHES;
+  touches[tail].x = x;
+  touches[tail].y = y;
+  count++;
+  return true;
+}
+
+// Drop every queued touch.
+void headless_clearTouches() {
+  head = 0;
+  count = 0;
+  pressReported = false;
+}
+
+/***********TOUCHSCREEN FUNCTIONS************/
+
+void touchscreen_init(double period_seconds) { headless_clearTouches(); }
+
+void touchscreen_tick() {}
+
+touchscreen_status_t touchscreen_get_status() {
+  return count ? TOUCHSCREEN_RELEASED : TOUCHSCREEN_IDLE;
+}
+
+void touchscreen_ack_touch() {
+  if (count == 0)
+    return;
+  head = (head + 1) % MAX_QUEUED_TOUCHES;
+  count--;
+  pressReported = false;
+}
+
+display_point_t touchscreen_get_location() {
+  display_point_t none = {0, 0};
+  return count ? touches[head] : none;
+}
+
+bool touchscreen_getEvent(touchscreen_event_t *event) {
+  if (count == 0)
+    return false;
+
+  event->location = touches[head];
+  event->time = timestamp_now();
+  if (!pressReported) {
+    event->type = TOUCHSCREEN_EVENT_PRESS;
+    pressReported = true;
+  } else {
+    event->type = TOUCHSCREEN_EVENT_RELEASE;
+    touchscreen_ack_touch();
+  }
+  return true;
+}
+
+uint32_t touchscreen_getDroppedEventCount() { return 0; }
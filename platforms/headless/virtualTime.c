@@ -0,0 +1,394 @@
+#include "virtualTime.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "armInterrupts.h"
+#include "headless.h"
+#include "xparameters.h"
+
+// All three timers run off the same clock, and virtual time is kept in its
+// cycles
+#define TIMER_COUNT 3
+#define CLOCK_FREQ_HZ HEADLESS_CLOCK_FREQ_HZ
+_Static_assert(HEADLESS_CLOCK_FREQ_HZ == XPAR_AXI_TIMER_0_CLOCK_FREQ_HZ,
+               "Virtual time must run at the AXI timers' clock");
+#define NO_EVENT UINT64_MAX
+
+#define SECONDS_TO_NS 1.0E9
+#define SECONDS_TO_US 1.0E6
+#define SECONDS_TO_MS 1.0E3
+#define PERCENT 100.0
+
+// Timer registers and control bits (see drivers/intervalTimer.c)
+#define TCSR0_OFFSET 0x00
+#define TLR0_OFFSET 0x04
+#define TCR0_OFFSET 0x08
+#define TCSR1_OFFSET 0x10
+#define TLR1_OFFSET 0x14
+#define TCR1_OFFSET 0x18
+
+#define UDT0_MASK 0x002
+#define ARHT0_MASK 0x010
+#define LOAD_MASK 0x020
+#define ENIT0_MASK 0x040
+#define ENT0_MASK 0x080
+#define T0INT_MASK 0x100
+
+// Interrupt controller registers (see drivers/interrupts.c)
+#define ISR_OFFSET 0x00
+#define IPR_OFFSET 0x04
+#define IER_OFFSET 0x08
+#define IAR_OFFSET 0x0C
+#define SIE_OFFSET 0x10
+#define CIE_OFFSET 0x14
+#define MER_OFFSET 0x1C
+
+#define MER_ME_MASK 0x1
+
+// One cascaded 64-bit timer. The counter is only brought up to date when it is
+// looked at: it held count at countTime, and has been running since if enabled.
+typedef struct {
+  uint32_t tcsr0;
+  uint32_t tcsr1;
+  uint32_t tlr0;
+  uint32_t tlr1;
+  uint64_t count;
+  uint64_t countTime;
+} virtualTimer_t;
+
+static virtualTimer_t timers[TIMER_COUNT];
+
+// Virtual time, in timer clock cycles
+static uint64_t now;
+
+// Interrupt controller
+static uint32_t intcIsr;
+static uint32_t intcIer;
+static uint32_t intcMer;
+
+// ARM side: the handler registered for the controller's output, and whether
+// IRQs are enabled
+static void (*intcHandler)();
+static bool armEnabled;
+static bool inHandler;
+static bool handlerAcked; // The running handler wrote the IAR
+
+// Pacing and timing report. Timestamps (timestamp.h) run in virtual time
+// here, so host time is read from the host clock directly, in nanoseconds.
+static bool paced;
+static bool started;
+static uint64_t hostStart;
+static uint32_t lineCounts[TIMER_COUNT];
+static uint32_t handlerCount;
+static uint64_t handlerTotal;
+static uint64_t handlerMax;
+
+/***********HELPER FUNCTIONS************/
+
+// Return the host's monotonic clock, in nanoseconds.
+static uint64_t hostNow() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * (uint64_t)SECONDS_TO_NS + ts.tv_nsec;
+}
+
+// Return the host time since start, in seconds.
+static double hostSeconds() { return (hostNow() - hostStart) / SECONDS_TO_NS; }
+
+// Start the host clock on first use.
+static void start() {
+  if (started)
+    return;
+  hostStart = hostNow();
+  started = true;
+}
+
+static bool isRunning(virtualTimer_t *t) { return t->tcsr0 & ENT0_MASK; }
+
+static bool countsDown(virtualTimer_t *t) { return t->tcsr0 & UDT0_MASK; }
+
+// Bring a timer's counter up to the current virtual time. Time never passes
+// an expiry without it being handled, so a down counter can't go below zero.
+static void syncTimer(virtualTimer_t *t) {
+  if (isRunning(t)) {
+    uint64_t elapsed = now - t->countTime;
+    t->count = countsDown(t) ? t->count - elapsed : t->count + elapsed;
+  }
+  t->countTime = now;
+}
+
+// Virtual time at which a timer next reaches zero, or NO_EVENT. Up counters
+// would take centuries to roll over, so they never do here.
+static uint64_t expiryTime(virtualTimer_t *t) {
+  if (!isRunning(t) || !countsDown(t))
+    return NO_EVENT;
+  return t->countTime + t->count;
+}
+
+// Handle a timer reaching zero: raise its interrupt, then reload it or stop.
+static void expire(virtualTimer_t *t) {
+  syncTimer(t);
+  t->tcsr0 |= T0INT_MASK;
+  uint64_t reload = ((uint64_t)t->tlr1 << 32) | t->tlr0;
+  if ((t->tcsr0 & ARHT0_MASK) && reload)
+    t->count = reload;
+  else
+    t->tcsr0 &= ~ENT0_MASK;
+}
+
+// Latch the timers' interrupt outputs into the controller. The timer lines
+// are level sensitive, so an acknowledged line comes back if it is still high.
+static void updateIntc() {
+  for (uint8_t i = 0; i < TIMER_COUNT; i++)
+    if ((timers[i].tcsr0 & T0INT_MASK) && (timers[i].tcsr0 & ENIT0_MASK))
+      intcIsr |= 1 << i;
+}
+
+static bool irqAsserted() {
+  return (intcMer & MER_ME_MASK) && (intcIsr & intcIer);
+}
+
+// Run the interrupt handler for as long as the controller asserts its output.
+// Handlers don't nest, as on the ARM, where IRQs are masked in a handler. A
+// handler that acknowledges nothing (a line enabled before its handler is
+// registered) would be called forever, so it is tried again at the next
+// event instead.
+static void deliverInterrupts() {
+  while (armEnabled && intcHandler && !inHandler && irqAsserted()) {
+    uint32_t pending = intcIsr & intcIer;
+    for (uint8_t i = 0; i < TIMER_COUNT; i++)
+      if (pending & (1 << i))
+        lineCounts[i]++;
+
+    inHandler = true;
+    handlerAcked = false;
+    uint64_t handlerStart = hostNow();
+    intcHandler();
+    uint64_t handlerTime = hostNow() - handlerStart;
+    handlerCount++;
+    handlerTotal += handlerTime;
+    if (handlerTime > handlerMax)
+      handlerMax = handlerTime;
+    inHandler = false;
+    if (!handlerAcked)
+      return;
+  }
+}
+
+// Index of the timer that expires first, or -1 if none is running.
+static int8_t nextTimer() {
+  int8_t next = -1;
+  uint64_t nextTime = NO_EVENT;
+  for (uint8_t i = 0; i < TIMER_COUNT; i++) {
+    uint64_t time = expiryTime(&timers[i]);
+    if (time < nextTime) {
+      nextTime = time;
+      next = i;
+    }
+  }
+  return next;
+}
+
+// Move virtual time to target, handling every expiry on the way in order.
+static void advanceTo(uint64_t target) {
+  start();
+  int8_t next;
+  while ((next = nextTimer()) >= 0 && expiryTime(&timers[next]) <= target) {
+    now = expiryTime(&timers[next]);
+    expire(&timers[next]);
+    updateIntc();
+    deliverInterrupts();
+  }
+  if (target > now)
+    now = target;
+}
+
+// Sleep until the host clock catches up with virtual time.
+static void pace() {
+  double ahead = headless_getTime() - hostSeconds();
+  if (ahead <= 0)
+    return;
+  struct timespec sleepTime = {(time_t)ahead,
+                               (ahead - (time_t)ahead) * SECONDS_TO_NS};
+  nanosleep(&sleepTime, NULL);
+}
+
+/***********REGISTER MODELS************/
+
+// Charge one register access to virtual time.
+void virtualTime_busAccess() { advanceTo(now + HEADLESS_BUS_ACCESS_CYCLES); }
+
+uint32_t virtualTime_readTimer(uint8_t timer, uint32_t offset) {
+  virtualTimer_t *t = &timers[timer];
+  switch (offset) {
+  case TCSR0_OFFSET:
+    return t->tcsr0;
+  case TLR0_OFFSET:
+    return t->tlr0;
+  case TCR0_OFFSET:
+    syncTimer(t);
+    return t->count;
+  case TCSR1_OFFSET:
+    return t->tcsr1;
+  case TLR1_OFFSET:
+    return t->tlr1;
+  case TCR1_OFFSET:
+    syncTimer(t);
+    return t->count >> 32;
+  default:
+    return 0;
+  }
+}
+
+void virtualTime_writeTimer(uint8_t timer, uint32_t offset, uint32_t value) {
+  virtualTimer_t *t = &timers[timer];
+  syncTimer(t);
+  switch (offset) {
+  case TCSR0_OFFSET:
+    // The interrupt bit is cleared by writing a one to it
+    if (value & T0INT_MASK)
+      t->tcsr0 &= ~T0INT_MASK;
+    t->tcsr0 = (value & ~T0INT_MASK) | (t->tcsr0 & T0INT_MASK);
+    if (value & LOAD_MASK)
+      t->count = (t->count & 0xFFFFFFFF00000000ULL) | t->tlr0;
+    break;
+  case TLR0_OFFSET:
+    t->tlr0 = value;
+    break;
+  case TCSR1_OFFSET:
+    t->tcsr1 = value;
+    if (value & LOAD_MASK)
+      t->count = ((uint64_t)t->tlr1 << 32) | (t->count & 0xFFFFFFFF);
+    break;
+  case TLR1_OFFSET:
+    t->tlr1 = value;
+    break;
+  }
+
+  // A counter loaded with zero would expire over and over at the same instant
+  if (isRunning(t) && countsDown(t) && !t->count)
+    t->tcsr0 &= ~ENT0_MASK;
+  updateIntc();
+  deliverInterrupts();
+}
+
+uint32_t virtualTime_readIntc(uint32_t offset) {
+  switch (offset) {
+  case ISR_OFFSET:
+    return intcIsr;
+  case IPR_OFFSET:
+    return intcIsr & intcIer;
+  case IER_OFFSET:
+    return intcIer;
+  case MER_OFFSET:
+    return intcMer;
+  default:
+    return 0;
+  }
+}
+
+void virtualTime_writeIntc(uint32_t offset, uint32_t value) {
+  switch (offset) {
+  case IER_OFFSET:
+    intcIer = value;
+    break;
+  case IAR_OFFSET:
+    intcIsr &= ~value;
+    handlerAcked = true;
+    break;
+  case SIE_OFFSET:
+    intcIer |= value;
+    break;
+  case CIE_OFFSET:
+    intcIer &= ~value;
+    break;
+  case MER_OFFSET:
+    intcMer = value;
+    break;
+  }
+  updateIntc();
+  deliverInterrupts();
+}
+
+/***********ARMINTERRUPTS FUNCTIONS************/
+
+int armInterrupts_init() {
+  armEnabled = false;
+  return 0;
+}
+
+int32_t armInterrupts_setupIntc(void (*isr)()) {
+  intcHandler = isr;
+  return 0;
+}
+
+void armInterrupts_enable() {
+  armEnabled = true;
+  deliverInterrupts();
+}
+
+void armInterrupts_disable() { armEnabled = false; }
+
+/***********HEADLESS FUNCTIONS************/
+
+// Return the virtual time since start.
+double headless_getTime() { return (double)now / CLOCK_FREQ_HZ; }
+
+// Return the virtual time since start, in timer clock cycles.
+uint64_t headless_getCycles() { return now; }
+
+// Move virtual time forward.
+void headless_advanceTime(double seconds) {
+  advanceTo(now + (uint64_t)(seconds * CLOCK_FREQ_HZ));
+  if (paced)
+    pace();
+}
+
+// Move virtual time forward to the next timer expiry.
+bool headless_runToNextEvent() {
+  int8_t next = nextTimer();
+  if (next < 0)
+    return false;
+  advanceTo(expiryTime(&timers[next]));
+  if (paced)
+    pace();
+  return true;
+}
+
+// Keep virtual time from running ahead of the host clock.
+void headless_setRealTimePacing(bool enable) {
+  start();
+  paced = enable;
+}
+
+// Print virtual and host time, interrupt counts and handler load.
+void headless_printTimingReport() {
+  start();
+  double virtualSeconds = headless_getTime();
+  double host = hostSeconds();
+  printf("Virtual time: %.3f s in %.3f s of host time (%.1fx real time)\n",
+         virtualSeconds, host, host ? virtualSeconds / host : 0.0);
+
+  for (uint8_t i = 0; i < TIMER_COUNT; i++) {
+    if (!lineCounts[i])
+      continue;
+    printf("IRQ %d: %lu interrupts, one every %.3f ms\n", i,
+           (unsigned long)lineCounts[i],
+           virtualSeconds / lineCounts[i] * SECONDS_TO_MS);
+  }
+  if (!handlerCount)
+    return;
+
+  // The handler's share of the virtual time is the share of the CPU it would
+  // need in real time on a CPU as fast as the host
+  double handlerSeconds = handlerTotal / SECONDS_TO_NS;
+  printf("Interrupt handler: %lu calls, average %.2f us, max %.2f us of host "
+         "time, %.2f%% of the virtual time\n",
+         (unsigned long)handlerCount,
+         handlerSeconds / handlerCount * SECONDS_TO_US,
+         handlerMax / SECONDS_TO_NS * SECONDS_TO_US,
+         virtualSeconds ? handlerSeconds / virtualSeconds * PERCENT : 0.0);
+}
@@ -0,0 +1,20 @@
+#ifndef VIRTUALTIME_H
+#define VIRTUALTIME_H
+
+#include <stdint.h>
+
+// Register models of the interval timers and the interrupt controller, for
+// the headless Xil_In32() and Xil_Out32(). Offsets are from the device's base
+// address.
+
+// Charge one register access to virtual time, delivering any interrupt that
+// comes due.
+void virtualTime_busAccess();
+
+uint32_t virtualTime_readTimer(uint8_t timer, uint32_t offset);
+void virtualTime_writeTimer(uint8_t timer, uint32_t offset, uint32_t value);
+
+uint32_t virtualTime_readIntc(uint32_t offset);
+void virtualTime_writeIntc(uint32_t offset, uint32_t value);
+
+#endif /* VIRTUALTIME_H */
@@ -0,0 +1,239 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "headless.h"
+#include "xil_io.h"
+#include "xparameters.h"
+
+#include "virtualTime.h"
+
+// Register accesses are dispatched through a table of peripherals sorted by
+// address. The interval timers and the interrupt controller are modeled in
+// virtual time (see virtualTime.c), the button and switch GPIOs read back the
+// inputs set with headless_setButtons() and headless_setSwitches(), and the
+// other peripherals are plain register files that read back what was written.
+// Accesses to addresses outside the table are dropped and read as zero. Every
+// access, mapped or not, moves virtual time forward and is counted for the
+// register profile.
+
+// Registers counted and stored per peripheral. Accesses above the last one
+// are counted together in the last slot.
+#define REGISTER_SLOTS 256
+#define OTHER_SLOT (REGISTER_SLOTS - 1)
+#define REGISTER_BYTES 4
+
+#define GPIO_DATA_OFFSET 0x00
+
+typedef struct device_t device_t;
+
+struct device_t {
+  const char *name;
+  uint32_t base;
+  uint32_t high;
+  uint8_t unit; // Timer number, for the timers
+  uint32_t (*read)(device_t *device, uint32_t offset);
+  void (*write)(device_t *device, uint32_t offset, uint32_t value);
+  uint32_t registers[REGISTER_SLOTS];
+  uint32_t reads[REGISTER_SLOTS];
+  uint32_t writes[REGISTER_SLOTS];
+};
+
+// Inputs read from the button and switch GPIOs
+static uint32_t buttons;
+static uint32_t switches;
+
+static uint32_t unmappedReads;
+static uint32_t unmappedWrites;
+
+/***********PERIPHERAL MODELS************/
+
+static uint32_t slot(uint32_t offset) {
+  uint32_t index = offset / REGISTER_BYTES;
+  return index < OTHER_SLOT ? index : OTHER_SLOT;
+}
+
+// Plain register file
+static uint32_t readRegisterFile(device_t *device, uint32_t offset) {
+  return device->registers[slot(offset)];
+}
+
+static void writeRegisterFile(device_t *device, uint32_t offset,
+                              uint32_t value) {
+  device->registers[slot(offset)] = value;
+}
+
+// GPIO inputs: the data register reads the input, everything else is stored
+static uint32_t readButtons(device_t *device, uint32_t offset) {
+  return offset == GPIO_DATA_OFFSET ? buttons
+                                    : readRegisterFile(device, offset);
+}
+
+static uint32_t readSwitches(device_t *device, uint32_t offset) {
+  return offset == GPIO_DATA_OFFSET ? switches
+                                    : readRegisterFile(device, offset);
+}
+
+static uint32_t readTimer(device_t *device, uint32_t offset) {
+  return virtualTime_readTimer(device->unit, offset);
+}
+
+static void writeTimer(device_t *device, uint32_t offset, uint32_t value) {
+  virtualTime_writeTimer(device->unit, offset, value);
+}
+
+static uint32_t readIntc(device_t *device, uint32_t offset) {
+  return virtualTime_readIntc(offset);
+}
+
+static void writeIntc(device_t *device, uint32_t offset, uint32_t value) {
+  virtualTime_writeIntc(offset, value);
+}
+
+// The peripherals, sorted by base address
+static device_t devices[] = {
+    {"PUSH_BUTTONS", XPAR_PUSH_BUTTONS_BASEADDR, XPAR_PUSH_BUTTONS_HIGHADDR, 0,
+     readButtons, writeRegisterFile},
+    {"LEDS", XPAR_LEDS_BASEADDR, XPAR_LEDS_HIGHADDR, 0, readRegisterFile,
+     writeRegisterFile},
+    {"SLIDE_SWITCHES", XPAR_SLIDE_SWITCHES_BASEADDR,
+     XPAR_SLIDE_SWITCHES_HIGHADDR, 0, readSwitches, writeRegisterFile},
+    {"TFT_CONTROL", XPAR_AXI_GPIO_TFT_CONTROL_BASEADDR,
+     XPAR_AXI_GPIO_TFT_CONTROL_HIGHADDR, 0, readRegisterFile,
+     writeRegisterFile},
+    {"TFT_DATA_BUS", XPAR_AXI_GPIO_TFT_DATA_BUS_BASEADDR,
+     XPAR_AXI_GPIO_TFT_DATA_BUS_HIGHADDR, 0, readRegisterFile,
+     writeRegisterFile},
+    {"AXI_INTC_0", XPAR_AXI_INTC_0_BASEADDR, XPAR_AXI_INTC_0_HIGHADDR, 0,
+     readIntc, writeIntc},
+    {"AXI_TIMER_0", XPAR_AXI_TIMER_0_BASEADDR, XPAR_AXI_TIMER_0_HIGHADDR, 0,
+     readTimer, writeTimer},
+    {"AXI_TIMER_1", XPAR_AXI_TIMER_1_BASEADDR, XPAR_AXI_TIMER_1_HIGHADDR, 1,
+     readTimer, writeTimer},
+    {"AXI_TIMER_2", XPAR_AXI_TIMER_2_BASEADDR, XPAR_AXI_TIMER_2_HIGHADDR, 2,
+     readTimer, writeTimer},
+    {"AXI_I2S_ADI_0", XPAR_AXI_I2S_ADI_0_S00_AXI_BASEADDR,
+     XPAR_AXI_I2S_ADI_0_S00_AXI_HIGHADDR, 0, readRegisterFile,
+     writeRegisterFile},
+    {"AXI_XADC_0", XPAR_AXI_XADC_0_BASEADDR, XPAR_AXI_XADC_0_HIGHADDR, 0,
+     readRegisterFile, writeRegisterFile},
+};
+
+#define DEVICE_COUNT (sizeof(devices) / sizeof(devices[0]))
+#define LEDS_DEVICE 1
+
+// Device of the last access. Drivers tend to access the same peripheral
+// several times in a row, so this usually saves the search.
+static device_t *lastDevice = &devices[0];
+
+/***********HELPER FUNCTIONS************/
+
+// Check once that the table is sorted and the ranges don't overlap, since the
+// search depends on it.
+static void checkTable() {
+  static bool checked = false;
+  if (checked)
+    return;
+  for (uint8_t i = 1; i < DEVICE_COUNT; i++) {
+    if (devices[i].base <= devices[i - 1].high) {
+      printf("xil_io: %s is out of order in the device table\n",
+             devices[i].name);
+      assert(false);
+    }
+  }
+  checked = true;
+}
+
+// Return the device an address belongs to, or NULL.
+static device_t *findDevice(uint32_t addr) {
+  if (addr >= lastDevice->base && addr <= lastDevice->high)
+    return lastDevice;
+
+  checkTable();
+  uint8_t low = 0;
+  uint8_t high = DEVICE_COUNT;
+  while (low < high) {
+    uint8_t middle = (low + high) / 2;
+    if (addr < devices[middle].base)
+      high = middle;
+    else if (addr > devices[middle].high)
+      low = middle + 1;
+    else
+      return lastDevice = &devices[middle];
+  }
+  return NULL;
+}
+
+/***********XIL_IO FUNCTIONS************/
+
+uint32_t Xil_In32(uint32_t Addr) {
+  virtualTime_busAccess();
+  device_t *device = findDevice(Addr);
+  if (!device) {
+    unmappedReads++;
+    return 0;
+  }
+  uint32_t offset = Addr - device->base;
+  device->reads[slot(offset)]++;
+  return device->read(device, offset);
+}
+
+void Xil_Out32(uint32_t Addr, uint32_t Value) {
+  virtualTime_busAccess();
+  device_t *device = findDevice(Addr);
+  if (!device) {
+    unmappedWrites++;
+    return;
+  }
+  uint32_t offset = Addr - device->base;
+  device->writes[slot(offset)]++;
+  device->write(device, offset, Value);
+}
+
+/***********HEADLESS FUNCTIONS************/
+
+// Set the buttons the push button GPIO reads.
+void headless_setButtons(uint8_t value) { buttons = value; }
+
+// Set the switches the slide switch GPIO reads.
+void headless_setSwitches(uint8_t value) { switches = value; }
+
+// Return the value last written to the LEDs.
+uint8_t headless_getLeds() {
+  return devices[LEDS_DEVICE].registers[slot(GPIO_DATA_OFFSET)];
+}
+
+// Print the access counts of every register that has been accessed.
+void headless_printRegisterProfile() {
+  printf("Register accesses:\n");
+  for (uint8_t i = 0; i < DEVICE_COUNT; i++) {
+    device_t *device = &devices[i];
+    for (uint32_t j = 0; j < REGISTER_SLOTS; j++) {
+      if (!device->reads[j] && !device->writes[j])
+        continue;
+      if (j == OTHER_SLOT)
+        printf("  %-14s other  : ", device->name);
+      else
+        printf("  %-14s +0x%03lx : ", device->name,
+               (unsigned long)(j * REGISTER_BYTES));
+      printf("%lu reads, %lu writes\n", (unsigned long)device->reads[j],
+             (unsigned long)device->writes[j]);
+    }
+  }
+  if (unmappedReads || unmappedWrites)
+    printf("  unmapped              : %lu reads, %lu writes\n",
+           (unsigned long)unmappedReads, (unsigned long)unmappedWrites);
+}
+
+// Clear every register access count.
+void headless_resetRegisterProfile() {
+  for (uint8_t i = 0; i < DEVICE_COUNT; i++) {
+    for (uint32_t j = 0; j < REGISTER_SLOTS; j++) {
+      devices[i].reads[j] = 0;
+      devices[i].writes[j] = 0;
+    }
+  }
+  unmappedReads = 0;
+  unmappedWrites = 0;
+}
@@ -1,4 +1,10 @@
 add_library(buttons_switches buttons.c switches.c)
-target_link_libraries(buttons_switches ${330_LIBS})
+target_link_libraries(buttons_switches ${330_LIBS} idle)
 
-add_library(intervalTimer intervalTimer.c)
\ No newline at end of file
+add_library(intervalTimer intervalTimer.c)
+
+add_library(timestamp timestamp.c)
+target_link_libraries(timestamp ${330_LIBS})
+
+add_library(idle idle.c)
+target_link_libraries(idle ${330_LIBS} timestamp)
\ No newline at end of file
@@ -1,8 +1,20 @@
 add_library(intervalTimer intervalTimer.c)
 target_link_libraries(intervalTimer ${330_LIBS})
 
+add_library(timestamp timestamp.c)
+target_link_libraries(timestamp ${330_LIBS})
+
+add_library(idle idle.c)
+target_link_libraries(idle ${330_LIBS} timestamp)
+
+add_library(scheduler scheduler.c)
+target_link_libraries(scheduler ${330_LIBS} intervalTimer timestamp idle)
+
 add_library(interrupts interrupts.c)
-target_link_libraries(interrupts ${330_LIBS})
+target_link_libraries(interrupts ${330_LIBS} timestamp)
 
 add_library(touchscreen touchscreen.c)
-target_link_libraries(touchscreen ${330_LIBS})
+target_link_libraries(touchscreen ${330_LIBS} timestamp)
+
+add_library(textField textField.c)
+target_link_libraries(textField ${330_LIBS})
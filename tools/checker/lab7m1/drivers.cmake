@@ -0,0 +1,5 @@
+add_library(taskRunner taskRunner.c)
+target_link_libraries(taskRunner ${330_LIBS})
+
+add_library(timestamp timestamp.c)
+target_link_libraries(timestamp ${330_LIBS})
\ No newline at end of file
@@ -1,11 +1,23 @@
 add_library(buttons_switches buttons.c switches.c)
-target_link_libraries(buttons_switches ${330_LIBS})
+target_link_libraries(buttons_switches ${330_LIBS} idle)
 
 add_library(intervalTimer intervalTimer.c)
 target_link_libraries(intervalTimer ${330_LIBS})
 
+add_library(timestamp timestamp.c)
+target_link_libraries(timestamp ${330_LIBS})
+
+add_library(idle idle.c)
+target_link_libraries(idle ${330_LIBS} timestamp)
+
+add_library(scheduler scheduler.c)
+target_link_libraries(scheduler ${330_LIBS} intervalTimer timestamp idle)
+
 add_library(interrupts interrupts.c)
-target_link_libraries(interrupts ${330_LIBS})
+target_link_libraries(interrupts ${330_LIBS} timestamp)
 
 add_library(touchscreen touchscreen.c)
-target_link_libraries(touchscreen ${330_LIBS})
\ No newline at end of file
+target_link_libraries(touchscreen ${330_LIBS} timestamp)
+
+add_library(taskRunner taskRunner.c)
+target_link_libraries(taskRunner ${330_LIBS})
\ No newline at end of file
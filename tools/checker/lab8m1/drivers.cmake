@@ -1,5 +1,17 @@
 add_library(intervalTimer intervalTimer.c)
 target_link_libraries(intervalTimer ${330_LIBS})
 
+add_library(timestamp timestamp.c)
+target_link_libraries(timestamp ${330_LIBS})
+
+add_library(idle idle.c)
+target_link_libraries(idle ${330_LIBS} timestamp)
+
 add_library(interrupts interrupts.c)
-target_link_libraries(interrupts ${330_LIBS})
+target_link_libraries(interrupts ${330_LIBS} timestamp)
+
+add_library(displayLine displayLine.c)
+target_link_libraries(displayLine ${330_LIBS})
+
+add_library(displayCircle displayCircle.c)
+target_link_libraries(displayCircle ${330_LIBS})
@@ -1,8 +1,29 @@
 add_library(intervalTimer intervalTimer.c)
 target_link_libraries(intervalTimer ${330_LIBS})
 
+add_library(timestamp timestamp.c)
+target_link_libraries(timestamp ${330_LIBS})
+
+add_library(idle idle.c)
+target_link_libraries(idle ${330_LIBS} timestamp)
+
 add_library(interrupts interrupts.c)
-target_link_libraries(interrupts ${330_LIBS})
+target_link_libraries(interrupts ${330_LIBS} timestamp)
 
 add_library(touchscreen touchscreen.c)
-target_link_libraries(touchscreen ${330_LIBS})
\ No newline at end of file
+target_link_libraries(touchscreen ${330_LIBS} timestamp)
+
+add_library(textField textField.c)
+target_link_libraries(textField ${330_LIBS})
+
+add_library(displayLine displayLine.c)
+target_link_libraries(displayLine ${330_LIBS})
+
+add_library(displayCircle displayCircle.c)
+target_link_libraries(displayCircle ${330_LIBS})
+
+add_library(framePacer framePacer.c)
+target_link_libraries(framePacer ${330_LIBS} timestamp idle)
+
+add_library(timerWheel timerWheel.c)
+target_link_libraries(timerWheel ${330_LIBS} intervalTimer)
\ No newline at end of file
@@ -1,11 +1,23 @@
 add_library(buttons_switches buttons.c switches.c)
-target_link_libraries(buttons_switches ${330_LIBS})
+target_link_libraries(buttons_switches ${330_LIBS} idle)
 
 add_library(intervalTimer intervalTimer.c)
 target_link_libraries(intervalTimer ${330_LIBS})
 
+add_library(timestamp timestamp.c)
+target_link_libraries(timestamp ${330_LIBS})
+
+add_library(idle idle.c)
+target_link_libraries(idle ${330_LIBS} timestamp)
+
 add_library(interrupts interrupts.c)
-target_link_libraries(interrupts ${330_LIBS})
+target_link_libraries(interrupts ${330_LIBS} timestamp)
 
 add_library(touchscreen touchscreen.c)
-target_link_libraries(touchscreen ${330_LIBS})
\ No newline at end of file
+target_link_libraries(touchscreen ${330_LIBS} timestamp)
+
+add_library(timerWheel timerWheel.c)
+target_link_libraries(timerWheel ${330_LIBS} intervalTimer)
+
+add_library(input input.c)
+target_link_libraries(input ${330_LIBS} buttons_switches timestamp m)
\ No newline at end of file